@@ -0,0 +1,131 @@
+#include "aho_corasick.h"
+#include <vector>
+#include <string>
+
+AhoCorasick construirAhoCorasick(const std::vector<std::string> &patrones)
+{
+    AhoCorasick ac;
+
+    // Asignar una clase a cada byte presente en los patrones
+    for (const auto &p : patrones)
+    {
+        for (unsigned char c : p)
+        {
+            if (ac.clase[c] == 0)
+                ac.clase[c] = ac.numClases++;
+        }
+    }
+    const int K = ac.numClases;
+
+    // Paso 1: trie de los patrones (-1 = sin hijo)
+    std::vector<int> &trans = ac.transiciones;
+    std::vector<std::vector<int>> propias(1);
+    trans.assign(K, -1);
+    ac.longitudes.resize(patrones.size());
+
+    for (int id = 0; id < (int)patrones.size(); ++id)
+    {
+        const std::string &p = patrones[id];
+        ac.longitudes[id] = p.size();
+        if (p.empty())
+            continue;
+
+        int nodo = 0;
+        for (unsigned char c : p)
+        {
+            int idx = nodo * K + ac.clase[c];
+            if (trans[idx] == -1)
+            {
+                trans[idx] = propias.size();
+                propias.emplace_back();
+                trans.resize(trans.size() + K, -1);
+            }
+            nodo = trans[idx];
+        }
+        propias[nodo].push_back(id);
+    }
+
+    // Paso 2: BFS para calcular enlaces de falla y completar las transiciones
+    int numNodos = propias.size();
+    std::vector<int> falla(numNodos, 0), orden;
+    orden.reserve(numNodos);
+    orden.push_back(0);
+    for (int c = 0; c < K; ++c)
+    {
+        int v = trans[c];
+        if (v == -1)
+            trans[c] = 0;
+        else
+            orden.push_back(v);
+    }
+    for (size_t i = 1; i < orden.size(); ++i)
+    {
+        int u = orden[i];
+        for (int c = 0; c < K; ++c)
+        {
+            int v = trans[u * K + c];
+            if (v == -1)
+            {
+                trans[u * K + c] = trans[falla[u] * K + c];
+            }
+            else
+            {
+                falla[v] = trans[falla[u] * K + c];
+                orden.push_back(v);
+            }
+        }
+    }
+
+    // Paso 3: las salidas de cada nodo son las propias mas las de su enlace de falla.
+    // En orden BFS el enlace de falla ya esta resuelto cuando se procesa el nodo.
+    std::vector<std::vector<int>> todas(numNodos);
+    for (int u : orden)
+    {
+        todas[u] = propias[u];
+        if (u != 0)
+            todas[u].insert(todas[u].end(), todas[falla[u]].begin(), todas[falla[u]].end());
+    }
+
+    ac.inicioSalidas.assign(numNodos + 1, 0);
+    for (int u = 0; u < numNodos; ++u)
+    {
+        ac.inicioSalidas[u + 1] = ac.inicioSalidas[u] + todas[u].size();
+    }
+    ac.salidas.reserve(ac.inicioSalidas[numNodos]);
+    for (int u = 0; u < numNodos; ++u)
+    {
+        ac.salidas.insert(ac.salidas.end(), todas[u].begin(), todas[u].end());
+    }
+
+    return ac;
+}
+
+template <typename Offset>
+std::vector<std::pair<int, Offset>> ahoCorasickSearch(const AhoCorasick &ac, std::string_view text)
+{
+    verificarTamTexto<Offset>(text.size());
+    std::vector<std::pair<int, Offset>> result;
+    if (ac.salidas.empty())
+        return result;
+
+    const int K = ac.numClases;
+    const int *trans = ac.transiciones.data();
+    const int *inicio = ac.inicioSalidas.data();
+    size_t n = text.size();
+    int nodo = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        nodo = trans[nodo * K + ac.clase[(unsigned char)text[i]]];
+        for (int k = inicio[nodo]; k < inicio[nodo + 1]; ++k)
+        {
+            int id = ac.salidas[k];
+            result.push_back({id, (Offset)(i - ac.longitudes[id] + 1)});
+        }
+    }
+
+    return result;
+}
+
+template std::vector<std::pair<int, Offset32>> ahoCorasickSearch<Offset32>(const AhoCorasick &, std::string_view);
+template std::vector<std::pair<int, Offset64>> ahoCorasickSearch<Offset64>(const AhoCorasick &, std::string_view);
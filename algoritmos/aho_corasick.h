@@ -0,0 +1,33 @@
+#ifndef AHO_CORASICK_H
+#define AHO_CORASICK_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include "resultados.h"
+
+// Automata de Aho-Corasick compilado para un conjunto de patrones.
+// Los bytes se agrupan en clases (solo los que aparecen en algun patron tienen
+// clase propia, el resto comparte la clase 0) y las transiciones completas se
+// guardan en un arreglo plano de nodos x numClases.
+struct AhoCorasick
+{
+    int numClases = 1;
+    unsigned char clase[256] = {};
+    std::vector<int> transiciones;  // transiciones[nodo * numClases + clase] = nodo destino
+    std::vector<int> inicioSalidas; // salidas del nodo i: [inicioSalidas[i], inicioSalidas[i + 1])
+    std::vector<int> salidas;       // ids de patrones reconocidos en cada nodo (incluye sus sufijos)
+    std::vector<int> longitudes;    // longitud de cada patron, por id
+};
+
+// Compila todos los patrones en un automata (los patrones vacios se ignoran)
+AhoCorasick construirAhoCorasick(const std::vector<std::string> &patrones);
+
+// Recorre el texto una sola vez y devuelve pares (id de patron, offset) por cada
+// coincidencia, en el orden en que terminan dentro del texto
+// (Offset32 por defecto; Offset64 para textos de mas de 2 GiB)
+template <typename Offset = Offset32>
+std::vector<std::pair<int, Offset>> ahoCorasickSearch(const AhoCorasick &ac, std::string_view text);
+
+#endif
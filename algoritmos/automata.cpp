@@ -1,33 +1,108 @@
 #include "automata.h"
 #include <vector>
 #include <string>
-#include <unordered_map>
 
 const int ASCII_SIZE = 256; // para ASCII extendido
 
-// Implementacion simplificada y robusta del algoritmo Automata
-std::vector<int> automataSearch(const std::string &text, const std::string &pattern)
+// Construye la tabla de transiciones del automata en un solo arreglo plano de
+// (m + 1) * ASCII_SIZE enteros. Cada entrada guarda el estado destino ya
+// multiplicado por ASCII_SIZE, asi la busqueda hace una sola suma y un acceso
+// por caracter. Se construye en O(m * ASCII_SIZE) usando el estado de respaldo
+// (equivalente al lps de KMP) en vez de probar todos los sufijos.
+void construirTablaTransiciones(std::string_view pattern, std::vector<int> &tabla)
 {
-    std::vector<int> result;
-    if (pattern.empty() || text.size() < pattern.size())
-        return result;
-
     int m = pattern.size();
-    int n = text.size();
+    tabla.assign((m + 1) * ASCII_SIZE, 0);
 
-    // Usar enfoque de fuerza bruta optimizado para mayor estabilidad
-    for (int i = 0; i <= n - m; ++i)
+    tabla[(unsigned char)pattern[0]] = 1 * ASCII_SIZE;
+
+    int respaldo = 0; // fila del estado de respaldo (ya multiplicada)
+    for (int q = 1; q <= m; ++q)
     {
-        int j = 0;
-        while (j < m && text[i + j] == pattern[j])
+        int fila = q * ASCII_SIZE;
+        for (int c = 0; c < ASCII_SIZE; ++c)
         {
-            j++;
+            tabla[fila + c] = tabla[respaldo + c];
         }
-        if (j == m)
+        if (q < m)
+        {
+            unsigned char c = pattern[q];
+            tabla[fila + c] = (q + 1) * ASCII_SIZE;
+            respaldo = tabla[respaldo + c];
+        }
+    }
+}
+
+PatronAutomata construirPatronAutomata(std::string_view pattern)
+{
+    PatronAutomata compilado;
+    compilado.patron = std::string(pattern);
+    if (!pattern.empty())
+        construirTablaTransiciones(pattern, compilado.tabla);
+    return compilado;
+}
+
+// Recorre el texto una sola vez: una consulta a la tabla por byte, sin retrocesos
+template <typename Offset>
+static void automataNucleo(std::string_view text, int m, const int *t, SumideroResultadosT<Offset> &sumidero)
+{
+    size_t n = text.size();
+    const int aceptacion = m * ASCII_SIZE;
+    int estado = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        estado = t[estado + (unsigned char)text[i]];
+        if (estado == aceptacion && !sumidero.reportar(i - m + 1))
         {
-            result.push_back(i);
+            return;
         }
     }
+}
 
+template <typename Offset>
+void automataSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero)
+{
+    verificarTamTexto<Offset>(text.size());
+    if (pattern.empty() || text.size() < pattern.size())
+        return;
+
+    std::vector<int> tabla;
+    construirTablaTransiciones(pattern, tabla);
+    automataNucleo(text, (int)pattern.size(), tabla.data(), sumidero);
+}
+
+template <typename Offset>
+void automataSearch(const PatronAutomata &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero)
+{
+    verificarTamTexto<Offset>(text.size());
+    if (compilado.patron.empty() || text.size() < compilado.patron.size())
+        return;
+    automataNucleo(text, (int)compilado.patron.size(), compilado.tabla.data(), sumidero);
+}
+
+template <typename Offset>
+std::vector<Offset> automataSearch(std::string_view text, std::string_view pattern)
+{
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    automataSearch(text, pattern, sumidero);
     return result;
 }
+
+template <typename Offset>
+std::vector<Offset> automataSearch(const PatronAutomata &compilado, std::string_view text)
+{
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    automataSearch(compilado, text, sumidero);
+    return result;
+}
+
+template std::vector<Offset32> automataSearch<Offset32>(std::string_view, std::string_view);
+template std::vector<Offset64> automataSearch<Offset64>(std::string_view, std::string_view);
+template void automataSearch<Offset32>(std::string_view, std::string_view, SumideroResultados &);
+template void automataSearch<Offset64>(std::string_view, std::string_view, SumideroResultados64 &);
+template std::vector<Offset32> automataSearch<Offset32>(const PatronAutomata &, std::string_view);
+template std::vector<Offset64> automataSearch<Offset64>(const PatronAutomata &, std::string_view);
+template void automataSearch<Offset32>(const PatronAutomata &, std::string_view, SumideroResultados &);
+template void automataSearch<Offset64>(const PatronAutomata &, std::string_view, SumideroResultados64 &);
@@ -2,9 +2,37 @@
 #define AUTOMATA_H
 
 #include <string>
+#include <string_view>
+#include "resultados.h"
 #include <vector>
 
+// Tabla de transiciones del automata del patron (no vacio): (m + 1) filas de
+// 256 enteros, con cada estado destino ya multiplicado por 256. El estado de
+// aceptacion es m * 256.
+void construirTablaTransiciones(std::string_view pattern, std::vector<int> &tabla);
+
+// Patron ya preprocesado: la tabla se arma una vez y se reutiliza en cada texto
+struct PatronAutomata
+{
+    std::string patron;
+    std::vector<int> tabla; // vacia si el patron es vacio
+};
+
+PatronAutomata construirPatronAutomata(std::string_view pattern);
+
 // Busca ocurrencias del patrón en el texto usando autómata finito
-std::vector<int> automataSearch(const std::string& text, const std::string& pattern);
+// (Offset32 por defecto; Offset64 para textos de mas de 2 GiB)
+template <typename Offset = Offset32>
+std::vector<Offset> automataSearch(std::string_view text, std::string_view pattern);
+
+// Igual, pero entrega cada offset al sumidero (sin armar el vector)
+template <typename Offset>
+void automataSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero);
+
+// Busqueda con la tabla ya construida
+template <typename Offset = Offset32>
+std::vector<Offset> automataSearch(const PatronAutomata &compilado, std::string_view text);
+template <typename Offset>
+void automataSearch(const PatronAutomata &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero);
 
 #endif
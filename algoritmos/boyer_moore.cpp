@@ -1,33 +1,269 @@
 #include "boyer_moore.h"
 #include <vector>
 #include <algorithm>
+#include <cstring>
 
-void preprocessBadChar(const std::string &pattern, std::vector<int> &badChar) {
-    badChar.assign(256, -1);
+// Ultima aparicion de cada byte en el patron (-1 si no aparece)
+static void preprocessBadChar(std::string_view pattern, int badChar[256]) {
+    for (int c = 0; c < 256; ++c) badChar[c] = -1;
     for (int i = 0; i < (int)pattern.size(); ++i) {
         badChar[(unsigned char)pattern[i]] = i;
     }
 }
 
-std::vector<int> boyerMooreSearch(const std::string &text, const std::string &pattern) {
-    std::vector<int> result;
-    int n = text.size(), m = pattern.size();
-    if (m == 0 || n < m) return result;
+// suff[i] = largo del mayor sufijo comun entre pattern[0..i] y el patron completo
+static void calcularSufijos(std::string_view pattern, std::vector<int> &suff) {
+    int m = pattern.size();
+    suff.assign(m, 0);
+    suff[m - 1] = m;
+    int f = m - 1, g = m - 1;
+    for (int i = m - 2; i >= 0; --i) {
+        if (i > g && suff[i + m - 1 - f] < i - g) {
+            suff[i] = suff[i + m - 1 - f];
+        } else {
+            if (i < g) g = i;
+            f = i;
+            while (g >= 0 && pattern[g] == pattern[g + m - 1 - f]) --g;
+            suff[i] = f - g;
+        }
+    }
+}
 
-    std::vector<int> badChar;
-    preprocessBadChar(pattern, badChar);
+// Tabla de buen sufijo: desplazamiento seguro cuando falla la posicion j
+static void preprocessGoodSuffix(std::string_view pattern, std::vector<int> &goodSuffix) {
+    int m = pattern.size();
+    std::vector<int> suff;
+    calcularSufijos(pattern, suff);
+
+    goodSuffix.assign(m, m);
+    // Caso 2: un prefijo del patron es sufijo del buen sufijo
+    for (int i = m - 1, j = 0; i >= 0; --i) {
+        if (suff[i] == i + 1) {
+            for (; j < m - 1 - i; ++j) {
+                if (goodSuffix[j] == m) goodSuffix[j] = m - 1 - i;
+            }
+        }
+    }
+    // Caso 1: el buen sufijo vuelve a aparecer dentro del patron
+    for (int i = 0; i <= m - 2; ++i) {
+        goodSuffix[m - 1 - suff[i]] = m - 1 - i;
+    }
+}
+
+// Tablas de desplazamiento de Horspool (byte alineado con el final del patron)
+// y de Sunday (byte que sigue a la ventana)
+static void preprocessHorspool(std::string_view pattern, int shift[256]) {
+    int m = pattern.size();
+    for (int c = 0; c < 256; ++c) shift[c] = m;
+    for (int i = 0; i < m - 1; ++i) shift[(unsigned char)pattern[i]] = m - 1 - i;
+}
+
+static void preprocessSunday(std::string_view pattern, int shift[256]) {
+    int m = pattern.size();
+    for (int c = 0; c < 256; ++c) shift[c] = m + 1;
+    for (int i = 0; i < m; ++i) shift[(unsigned char)pattern[i]] = m - i;
+}
+
+PatronBoyerMoore construirPatronBoyerMoore(std::string_view pattern) {
+    PatronBoyerMoore compilado;
+    compilado.patron = std::string(pattern);
+    preprocessBadChar(pattern, compilado.badChar.data());
+    if (!pattern.empty()) preprocessGoodSuffix(pattern, compilado.goodSuffix);
+    return compilado;
+}
+
+PatronHorspool construirPatronHorspool(std::string_view pattern) {
+    PatronHorspool compilado;
+    compilado.patron = std::string(pattern);
+    preprocessHorspool(pattern, compilado.shift.data());
+    return compilado;
+}
+
+PatronSunday construirPatronSunday(std::string_view pattern) {
+    PatronSunday compilado;
+    compilado.patron = std::string(pattern);
+    preprocessSunday(pattern, compilado.shift.data());
+    return compilado;
+}
+
+// Boyer-Moore completo: mal caracter + buen sufijo, con la regla de Galil
+// (tras una coincidencia el prefijo ya verificado no se vuelve a comparar),
+// lo que deja el peor caso en tiempo lineal.
+template <typename Offset>
+static void boyerMooreNucleo(std::string_view text, std::string_view pattern, const int *badChar,
+                             const int *goodSuffix, SumideroResultadosT<Offset> &sumidero) {
+    size_t n = text.size();
+    int m = pattern.size();
+    const int periodo = goodSuffix[0];
 
-    int s = 0;
+    size_t s = 0;
+    int conocido = 0; // pattern[0..conocido) ya coincide en esta alineacion (Galil)
     while (s <= n - m) {
         int j = m - 1;
-        while (j >= 0 && pattern[j] == text[s + j]) j--;
+        while (j >= conocido && pattern[j] == text[s + j]) j--;
 
-        if (j < 0) {
-            result.push_back(s);
-            s += (s + m < n) ? m - badChar[(unsigned char)text[s + m]] : 1;
+        if (j < conocido) {
+            if (!sumidero.reportar(s)) return;
+            s += periodo;
+            conocido = m - periodo;
         } else {
-            s += std::max(1, j - badChar[(unsigned char)text[s + j]]);
+            s += std::max(goodSuffix[j], j - badChar[(unsigned char)text[s + j]]);
+            conocido = 0;
         }
     }
+}
+
+// Horspool: solo mal caracter, tomado del byte alineado con el final del patron
+template <typename Offset>
+static void horspoolNucleo(std::string_view text, std::string_view pattern, const int *shift,
+                           SumideroResultadosT<Offset> &sumidero) {
+    size_t n = text.size();
+    int m = pattern.size();
+    const char ultimo = pattern[m - 1];
+    size_t s = 0;
+    while (s <= n - m) {
+        char c = text[s + m - 1];
+        if (c == ultimo && std::memcmp(text.data() + s, pattern.data(), m - 1) == 0 && !sumidero.reportar(s))
+            return;
+        s += shift[(unsigned char)c];
+    }
+}
+
+// Sunday (quick search): el desplazamiento lo decide el byte que sigue a la ventana
+template <typename Offset>
+static void sundayNucleo(std::string_view text, std::string_view pattern, const int *shift,
+                         SumideroResultadosT<Offset> &sumidero) {
+    size_t n = text.size();
+    int m = pattern.size();
+    size_t s = 0;
+    while (s <= n - m) {
+        if (std::memcmp(text.data() + s, pattern.data(), m) == 0 && !sumidero.reportar(s))
+            return;
+        if (s + m >= n) break;
+        s += shift[(unsigned char)text[s + m]];
+    }
+}
+
+// Sin patron compilado: las tablas se arman en la pila en cada llamada
+template <typename Offset>
+void boyerMooreSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero) {
+    verificarTamTexto<Offset>(text.size());
+    if (pattern.empty() || text.size() < pattern.size()) return;
+    int badChar[256];
+    preprocessBadChar(pattern, badChar);
+    std::vector<int> goodSuffix;
+    preprocessGoodSuffix(pattern, goodSuffix);
+    boyerMooreNucleo(text, pattern, badChar, goodSuffix.data(), sumidero);
+}
+
+template <typename Offset>
+void horspoolSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero) {
+    verificarTamTexto<Offset>(text.size());
+    if (pattern.empty() || text.size() < pattern.size()) return;
+    int shift[256];
+    preprocessHorspool(pattern, shift);
+    horspoolNucleo(text, pattern, shift, sumidero);
+}
+
+template <typename Offset>
+void sundaySearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero) {
+    verificarTamTexto<Offset>(text.size());
+    if (pattern.empty() || text.size() < pattern.size()) return;
+    int shift[256];
+    preprocessSunday(pattern, shift);
+    sundayNucleo(text, pattern, shift, sumidero);
+}
+
+template <typename Offset>
+void boyerMooreSearch(const PatronBoyerMoore &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero) {
+    verificarTamTexto<Offset>(text.size());
+    if (compilado.patron.empty() || text.size() < compilado.patron.size()) return;
+    boyerMooreNucleo(text, compilado.patron, compilado.badChar.data(), compilado.goodSuffix.data(), sumidero);
+}
+
+template <typename Offset>
+void horspoolSearch(const PatronHorspool &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero) {
+    verificarTamTexto<Offset>(text.size());
+    if (compilado.patron.empty() || text.size() < compilado.patron.size()) return;
+    horspoolNucleo(text, compilado.patron, compilado.shift.data(), sumidero);
+}
+
+template <typename Offset>
+void sundaySearch(const PatronSunday &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero) {
+    verificarTamTexto<Offset>(text.size());
+    if (compilado.patron.empty() || text.size() < compilado.patron.size()) return;
+    sundayNucleo(text, compilado.patron, compilado.shift.data(), sumidero);
+}
+
+template <typename Offset>
+std::vector<Offset> boyerMooreSearch(std::string_view text, std::string_view pattern) {
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    boyerMooreSearch(text, pattern, sumidero);
+    return result;
+}
+
+template <typename Offset>
+std::vector<Offset> horspoolSearch(std::string_view text, std::string_view pattern) {
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    horspoolSearch(text, pattern, sumidero);
+    return result;
+}
+
+template <typename Offset>
+std::vector<Offset> sundaySearch(std::string_view text, std::string_view pattern) {
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    sundaySearch(text, pattern, sumidero);
+    return result;
+}
+
+template <typename Offset>
+std::vector<Offset> boyerMooreSearch(const PatronBoyerMoore &compilado, std::string_view text) {
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    boyerMooreSearch(compilado, text, sumidero);
     return result;
 }
+
+template <typename Offset>
+std::vector<Offset> horspoolSearch(const PatronHorspool &compilado, std::string_view text) {
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    horspoolSearch(compilado, text, sumidero);
+    return result;
+}
+
+template <typename Offset>
+std::vector<Offset> sundaySearch(const PatronSunday &compilado, std::string_view text) {
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    sundaySearch(compilado, text, sumidero);
+    return result;
+}
+
+template std::vector<Offset32> boyerMooreSearch<Offset32>(std::string_view, std::string_view);
+template std::vector<Offset64> boyerMooreSearch<Offset64>(std::string_view, std::string_view);
+template void boyerMooreSearch<Offset32>(std::string_view, std::string_view, SumideroResultados &);
+template void boyerMooreSearch<Offset64>(std::string_view, std::string_view, SumideroResultados64 &);
+template std::vector<Offset32> horspoolSearch<Offset32>(std::string_view, std::string_view);
+template std::vector<Offset64> horspoolSearch<Offset64>(std::string_view, std::string_view);
+template void horspoolSearch<Offset32>(std::string_view, std::string_view, SumideroResultados &);
+template void horspoolSearch<Offset64>(std::string_view, std::string_view, SumideroResultados64 &);
+template std::vector<Offset32> sundaySearch<Offset32>(std::string_view, std::string_view);
+template std::vector<Offset64> sundaySearch<Offset64>(std::string_view, std::string_view);
+template void sundaySearch<Offset32>(std::string_view, std::string_view, SumideroResultados &);
+template void sundaySearch<Offset64>(std::string_view, std::string_view, SumideroResultados64 &);
+template std::vector<Offset32> boyerMooreSearch<Offset32>(const PatronBoyerMoore &, std::string_view);
+template std::vector<Offset64> boyerMooreSearch<Offset64>(const PatronBoyerMoore &, std::string_view);
+template void boyerMooreSearch<Offset32>(const PatronBoyerMoore &, std::string_view, SumideroResultados &);
+template void boyerMooreSearch<Offset64>(const PatronBoyerMoore &, std::string_view, SumideroResultados64 &);
+template std::vector<Offset32> horspoolSearch<Offset32>(const PatronHorspool &, std::string_view);
+template std::vector<Offset64> horspoolSearch<Offset64>(const PatronHorspool &, std::string_view);
+template void horspoolSearch<Offset32>(const PatronHorspool &, std::string_view, SumideroResultados &);
+template void horspoolSearch<Offset64>(const PatronHorspool &, std::string_view, SumideroResultados64 &);
+template std::vector<Offset32> sundaySearch<Offset32>(const PatronSunday &, std::string_view);
+template std::vector<Offset64> sundaySearch<Offset64>(const PatronSunday &, std::string_view);
+template void sundaySearch<Offset32>(const PatronSunday &, std::string_view, SumideroResultados &);
+template void sundaySearch<Offset64>(const PatronSunday &, std::string_view, SumideroResultados64 &);
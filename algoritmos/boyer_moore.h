@@ -2,9 +2,67 @@
 #define BOYER_MOORE_H
 
 #include <string>
+#include <string_view>
+#include "resultados.h"
 #include <vector>
+#include <array>
 
 // Devuelve todos los offsets donde 'pattern' aparece en 'text'
-std::vector<int> boyerMooreSearch(const std::string &text, const std::string &pattern);
+// (Boyer-Moore completo: mal caracter + buen sufijo con regla de Galil).
+// Offset32 por defecto; Offset64 para textos de mas de 2 GiB.
+template <typename Offset = Offset32>
+std::vector<Offset> boyerMooreSearch(std::string_view text, std::string_view pattern);
+
+// Variante de Horspool (solo mal caracter, tabla en la pila)
+template <typename Offset = Offset32>
+std::vector<Offset> horspoolSearch(std::string_view text, std::string_view pattern);
+
+// Variante de Sunday / quick search (byte siguiente a la ventana, tabla en la pila)
+template <typename Offset = Offset32>
+std::vector<Offset> sundaySearch(std::string_view text, std::string_view pattern);
+
+// Versiones que entregan cada offset al sumidero (sin armar el vector)
+template <typename Offset>
+void boyerMooreSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero);
+template <typename Offset>
+void horspoolSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero);
+template <typename Offset>
+void sundaySearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero);
+
+// Patrones ya preprocesados: las tablas de desplazamiento se calculan una vez
+// y se reutilizan en cada texto o documento
+struct PatronBoyerMoore {
+    std::string patron;
+    std::array<int, 256> badChar;
+    std::vector<int> goodSuffix;
+};
+
+struct PatronHorspool {
+    std::string patron;
+    std::array<int, 256> shift;
+};
+
+struct PatronSunday {
+    std::string patron;
+    std::array<int, 256> shift;
+};
+
+PatronBoyerMoore construirPatronBoyerMoore(std::string_view pattern);
+PatronHorspool construirPatronHorspool(std::string_view pattern);
+PatronSunday construirPatronSunday(std::string_view pattern);
+
+template <typename Offset = Offset32>
+std::vector<Offset> boyerMooreSearch(const PatronBoyerMoore &compilado, std::string_view text);
+template <typename Offset = Offset32>
+std::vector<Offset> horspoolSearch(const PatronHorspool &compilado, std::string_view text);
+template <typename Offset = Offset32>
+std::vector<Offset> sundaySearch(const PatronSunday &compilado, std::string_view text);
+
+template <typename Offset>
+void boyerMooreSearch(const PatronBoyerMoore &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero);
+template <typename Offset>
+void horspoolSearch(const PatronHorspool &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero);
+template <typename Offset>
+void sundaySearch(const PatronSunday &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero);
 
 #endif
@@ -0,0 +1,298 @@
+#include "busqueda_aproximada.h"
+#include "aho_corasick.h"
+#include "simd.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+// Largo maximo de patron para los recorridos bit-paralelos (una palabra)
+const int MAX_BITS = 64;
+
+// Con trozos de al menos este largo el filtro por palomar descarta casi todo
+// el texto y conviene tambien para patrones cortos; con hasta TROZOS_SIMD
+// trozos cada uno se busca con el filtro SIMD, con mas en una pasada de
+// Aho-Corasick
+const size_t LARGO_MIN_TROZO = 4;
+const size_t TROZOS_SIMD = 4;
+
+// Separador de documentos del corpus concatenado: ninguna coincidencia lo
+// contiene, asi no se acredita a un documento un texto que cruza al siguiente
+const char SEPARADOR = '$';
+
+// Bits de las posiciones del patron donde aparece cada byte
+static void construirPeq(std::string_view pattern, std::array<uint64_t, 256> &peq)
+{
+    peq.fill(0);
+    for (size_t j = 0; j < pattern.size(); ++j)
+    {
+        peq[(unsigned char)pattern[j]] |= 1ULL << j;
+    }
+}
+
+// Myers (version de Hyyro): la columna de la matriz de distancias se guarda
+// como diferencias verticales +1 / -1 (Pv, Mv) y se avanza con operaciones de
+// palabra. 'puntaje' es la distancia del patron completo terminando en i.
+template <typename Offset>
+static void myersNucleo(std::string_view text, std::string_view pattern, int k, SumideroResultadosT<Offset> &sumidero)
+{
+    std::array<uint64_t, 256> peq;
+    construirPeq(pattern, peq);
+
+    int m = pattern.size();
+    const uint64_t ultimo = 1ULL << (m - 1);
+    uint64_t pv = ~0ULL, mv = 0;
+    int puntaje = m;
+    const unsigned char *t = reinterpret_cast<const unsigned char *>(text.data());
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        if (t[i] == SEPARADOR)
+        {
+            // Otro documento: la columna vuelve a la del inicio del texto
+            pv = ~0ULL;
+            mv = 0;
+            puntaje = m;
+            continue;
+        }
+        uint64_t eq = peq[t[i]];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & ultimo)
+            ++puntaje;
+        else if (mh & ultimo)
+            --puntaje;
+        // Sin '| 1' en ph: la coincidencia puede empezar en cualquier posicion
+        ph <<= 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        if (puntaje <= k && !sumidero.reportar(i))
+            return;
+    }
+}
+
+// Wu-Manber (Shift-And con errores): r[j] tiene el bit i en 1 si los ultimos
+// i + 1 bytes coinciden con el prefijo de largo i + 1 con a lo sumo j sustituciones
+template <typename Offset>
+static void hammingNucleo(std::string_view text, std::string_view pattern, int k, SumideroResultadosT<Offset> &sumidero)
+{
+    std::array<uint64_t, 256> peq;
+    construirPeq(pattern, peq);
+
+    int m = pattern.size();
+    const uint64_t ultimo = 1ULL << (m - 1);
+    std::vector<uint64_t> r(k + 1, 0);
+    const unsigned char *t = reinterpret_cast<const unsigned char *>(text.data());
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        if (t[i] == SEPARADOR)
+        {
+            std::fill(r.begin(), r.end(), 0);
+            continue;
+        }
+        uint64_t eq = peq[t[i]];
+        // De mayor a menor j: r[j - 1] todavia es el del byte anterior
+        for (int j = k; j > 0; --j)
+            r[j] = (((r[j] << 1) | 1) & eq) | ((r[j - 1] << 1) | 1);
+        r[0] = ((r[0] << 1) | 1) & eq;
+        if ((r[k] & ultimo) && !sumidero.reportar(i))
+            return;
+    }
+}
+
+// Posiciones finales en text[desde, hasta) con distancia de edicion <= k
+// (inicio libre) y sin cruzar un separador: Myers si el patron cabe en una
+// palabra, si no programacion dinamica de Sellers columna por columna
+static void verificarEdicion(std::string_view text, size_t desde, size_t hasta, std::string_view pattern, int k,
+                             std::vector<size_t> &finales)
+{
+    int m = pattern.size();
+    if (m <= MAX_BITS)
+    {
+        std::vector<int64_t> locales;
+        SumideroResultadosT<int64_t> sumidero = sumideroAgregar(locales);
+        myersNucleo(text.substr(desde, hasta - desde), pattern, k, sumidero);
+        for (int64_t fin : locales)
+            finales.push_back(desde + fin);
+        return;
+    }
+
+    std::vector<int> columna(m + 1);
+    for (int j = 0; j <= m; ++j)
+        columna[j] = j;
+    for (size_t i = desde; i < hasta; ++i)
+    {
+        if (text[i] == SEPARADOR)
+        {
+            for (int j = 0; j <= m; ++j)
+                columna[j] = j;
+            continue;
+        }
+        int diagonal = 0; // columna[0] anterior: siempre 0
+        for (int j = 1; j <= m; ++j)
+        {
+            int arriba = columna[j];
+            int costo = pattern[j - 1] == text[i] ? 0 : 1;
+            columna[j] = std::min({arriba + 1, columna[j - 1] + 1, diagonal + costo});
+            diagonal = arriba;
+        }
+        if (columna[m] <= k)
+            finales.push_back(i);
+    }
+}
+
+// Cantidad de bytes distintos entre el patron y text[inicio, inicio + m), cortando al pasar k;
+// k + 1 si la ventana contiene un separador
+static int distanciaHamming(std::string_view text, size_t inicio, std::string_view pattern, int k)
+{
+    int errores = 0;
+    for (size_t j = 0; j < pattern.size() && errores <= k; ++j)
+    {
+        if (text[inicio + j] == SEPARADOR)
+            return k + 1;
+        errores += text[inicio + j] != pattern[j];
+    }
+    return errores;
+}
+
+// Aciertos exactos (trozo, inicio) de los trozos en el texto
+static std::vector<std::pair<int, int64_t>> aciertosTrozos(std::string_view text, const std::vector<std::string> &piezas)
+{
+    if (piezas.size() > TROZOS_SIMD)
+        return ahoCorasickSearch<int64_t>(construirAhoCorasick(piezas), text);
+
+    std::vector<std::pair<int, int64_t>> aciertos;
+    for (size_t id = 0; id < piezas.size(); ++id)
+    {
+        for (int64_t pos : simdSearch<int64_t>(text, piezas[id]))
+            aciertos.emplace_back((int)id, pos);
+    }
+    return aciertos;
+}
+
+// Filtro por palomar: posiciones finales ordenadas y sin repetir
+static std::vector<size_t> filtroPalomar(std::string_view text, std::string_view pattern, int k, TipoError tipo)
+{
+    size_t n = text.size(), m = pattern.size();
+    std::vector<size_t> finales;
+
+    if (m / ((size_t)k + 1) < LARGO_MIN_TROZO)
+    {
+        // Trozos vacios o muy cortos: casi todo el texto seria candidato y las
+        // ventanas se solaparian, conviene verificar todo el texto de una vez
+        if (tipo == TipoError::Edicion)
+            verificarEdicion(text, 0, n, pattern, k, finales);
+        else
+            for (size_t s = 0; s + m <= n; ++s)
+            {
+                if (distanciaHamming(text, s, pattern, k) <= k)
+                    finales.push_back(s + m - 1);
+            }
+        return finales;
+    }
+
+    // k + 1 trozos consecutivos de largo parecido
+    size_t trozos = k + 1;
+    std::vector<std::string> piezas;
+    std::vector<size_t> inicioPieza;
+    for (size_t p = 0; p < trozos; ++p)
+    {
+        size_t a = m * p / trozos, b = m * (p + 1) / trozos;
+        piezas.push_back(std::string(pattern.substr(a, b - a)));
+        inicioPieza.push_back(a);
+    }
+
+    for (const auto &[id, pos] : aciertosTrozos(text, piezas))
+    {
+        // Un trozo con separador no puede ser parte de una coincidencia
+        if (piezas[id].find(SEPARADOR) != std::string::npos)
+            continue;
+        int64_t inicio = pos - (int64_t)inicioPieza[id]; // inicio alineado del patron
+        if (tipo == TipoError::Sustitucion)
+        {
+            if (inicio >= 0 && (size_t)inicio + m <= n && distanciaHamming(text, inicio, pattern, k) <= k)
+                finales.push_back(inicio + m - 1);
+        }
+        else
+        {
+            // Con k ediciones el patron se corre a lo sumo k posiciones; la
+            // ventana se recorta en los separadores que rodean al trozo
+            size_t desde = std::max<int64_t>(0, inicio - k);
+            size_t hasta = std::min<int64_t>(n, inicio + (int64_t)m + k);
+            for (size_t i = pos; i > desde; --i)
+            {
+                if (text[i - 1] == SEPARADOR)
+                {
+                    desde = i;
+                    break;
+                }
+            }
+            for (size_t i = pos + piezas[id].size(); i < hasta; ++i)
+            {
+                if (text[i] == SEPARADOR)
+                {
+                    hasta = i;
+                    break;
+                }
+            }
+            verificarEdicion(text, desde, hasta, pattern, k, finales);
+        }
+    }
+    std::sort(finales.begin(), finales.end());
+    finales.erase(std::unique(finales.begin(), finales.end()), finales.end());
+    return finales;
+}
+
+template <typename Offset>
+void busquedaAproximada(std::string_view text, std::string_view pattern, int k, TipoError tipo,
+                        SumideroResultadosT<Offset> &sumidero)
+{
+    verificarTamTexto<Offset>(text.size());
+    if (pattern.empty() || k < 0)
+        return;
+
+    size_t m = pattern.size();
+    if (m <= (size_t)MAX_BITS && m / ((size_t)k + 1) < LARGO_MIN_TROZO)
+    {
+        if (tipo == TipoError::Edicion)
+            myersNucleo(text, pattern, k, sumidero);
+        else
+            hammingNucleo(text, pattern, std::min<int>(k, pattern.size()), sumidero);
+        return;
+    }
+
+    for (size_t fin : filtroPalomar(text, pattern, k, tipo))
+    {
+        if (!sumidero.reportar(fin))
+            return;
+    }
+}
+
+template <typename Offset>
+std::vector<Offset> busquedaAproximada(std::string_view text, std::string_view pattern, int k, TipoError tipo)
+{
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    busquedaAproximada(text, pattern, k, tipo, sumidero);
+    return result;
+}
+
+template <typename Offset>
+std::vector<Offset> agruparFinalesVecinos(const std::vector<Offset> &finales)
+{
+    std::vector<Offset> result;
+    for (size_t i = 0; i < finales.size(); ++i)
+    {
+        if (i == 0 || finales[i] != finales[i - 1] + 1)
+            result.push_back(finales[i]);
+    }
+    return result;
+}
+
+template std::vector<Offset32> busquedaAproximada<Offset32>(std::string_view, std::string_view, int, TipoError);
+template std::vector<Offset64> busquedaAproximada<Offset64>(std::string_view, std::string_view, int, TipoError);
+template void busquedaAproximada<Offset32>(std::string_view, std::string_view, int, TipoError, SumideroResultados &);
+template void busquedaAproximada<Offset64>(std::string_view, std::string_view, int, TipoError, SumideroResultados64 &);
+template std::vector<Offset32> agruparFinalesVecinos<Offset32>(const std::vector<Offset32> &);
+template std::vector<Offset64> agruparFinalesVecinos<Offset64>(const std::vector<Offset64> &);
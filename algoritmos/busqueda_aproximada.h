@@ -0,0 +1,48 @@
+#ifndef BUSQUEDA_APROXIMADA_H
+#define BUSQUEDA_APROXIMADA_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "resultados.h"
+
+// Que errores admite la busqueda aproximada
+enum class TipoError
+{
+    Sustitucion, // k bytes distintos, mismo largo (distancia de Hamming)
+    Edicion      // k inserciones, borrados o sustituciones (distancia de Levenshtein)
+};
+
+// Busqueda aproximada: coincidencias del patron con a lo sumo k errores.
+// Cada coincidencia se reporta por la posicion de su ultimo byte en el texto
+// (una por posicion final, en orden creciente), asi las posiciones sirven
+// directo para ubicarEnDocumentos / histogramaDocumentos. Con ediciones, una
+// misma ocurrencia suele aparecer en varias posiciones finales vecinas.
+//
+// Ningun resultado contiene el separador de documentos '$': las coincidencias
+// quedan dentro de un documento, como en la busqueda exacta.
+//
+// Filtro por palomar: el patron se parte en k + 1 trozos y alguno aparece
+// exacto en toda coincidencia. Los trozos se buscan con los motores exactos
+// (SIMD, o Aho-Corasick si son muchos) y solo alrededor de cada acierto se
+// verifica (Myers si el patron cabe en 64 bits, programacion dinamica si no).
+// Se usa con patrones largos y siempre que los trozos tengan al menos 4 bytes,
+// asi con k chico el costo es cercano al de la busqueda exacta. Si los trozos
+// quedan mas cortos, el patron (de hasta 64 bytes) se busca con un recorrido
+// bit-paralelo: Myers para ediciones, Wu-Manber para sustituciones.
+// Offset32 por defecto; Offset64 para textos de mas de 2 GiB.
+template <typename Offset = Offset32>
+std::vector<Offset> busquedaAproximada(std::string_view text, std::string_view pattern, int k,
+                                       TipoError tipo = TipoError::Edicion);
+
+// Entrega cada posicion final al sumidero (sin armar el vector)
+template <typename Offset>
+void busquedaAproximada(std::string_view text, std::string_view pattern, int k, TipoError tipo,
+                        SumideroResultadosT<Offset> &sumidero);
+
+// Una posicion (la primera) por cada racha de posiciones finales consecutivas:
+// cuenta ocurrencias en vez de finales. Las rachas nunca cruzan un '$'.
+template <typename Offset>
+std::vector<Offset> agruparFinalesVecinos(const std::vector<Offset> &finales);
+
+#endif
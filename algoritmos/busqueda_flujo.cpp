@@ -0,0 +1,161 @@
+#include "busqueda_flujo.h"
+#include "kmp.h"
+#include "automata.h"
+#include "rabin_karp.h"
+#include "io.h"
+#include <cstring>
+
+BuscadorFlujo crearBuscadorFlujo(std::string_view patron, AlgoritmoFlujo algoritmo)
+{
+    BuscadorFlujo b;
+    b.algoritmo = algoritmo;
+    b.patron = std::string(patron);
+    switch (algoritmo)
+    {
+    case AlgoritmoFlujo::KMP:
+        buildLPS(patron, b.lps);
+        break;
+    case AlgoritmoFlujo::Automata:
+        construirTablaTransiciones(patron, b.tabla);
+        break;
+    case AlgoritmoFlujo::RabinKarp:
+        b.hashPatron = hashRabinKarp(patron);
+        b.potencia = potenciaRabinKarp(patron.size());
+        b.anillo.reserve(patron.size());
+        break;
+    }
+    return b;
+}
+
+void reiniciarBuscador(BuscadorFlujo &b)
+{
+    b.procesados = 0;
+    b.j = 0;
+    b.estado = 0;
+    b.hashVentana = 0;
+    b.anillo.clear();
+    b.cabeza = 0;
+}
+
+static bool alimentarKMP(BuscadorFlujo &b, std::string_view bloque, SumideroResultados64 &sumidero)
+{
+    const char *p = b.patron.data();
+    int m = b.patron.size();
+    int j = b.j;
+    for (size_t i = 0; i < bloque.size(); ++i)
+    {
+        while (j > 0 && bloque[i] != p[j])
+            j = b.lps[j - 1];
+        if (bloque[i] == p[j])
+            j++;
+        if (j == m)
+        {
+            if (!sumidero.reportar(b.procesados + i + 1 - m))
+                return false;
+            j = b.lps[j - 1];
+        }
+    }
+    b.j = j;
+    return true;
+}
+
+static bool alimentarAutomata(BuscadorFlujo &b, std::string_view bloque, SumideroResultados64 &sumidero)
+{
+    const int *t = b.tabla.data();
+    int m = b.patron.size();
+    const int aceptacion = m * 256;
+    int estado = b.estado;
+    for (size_t i = 0; i < bloque.size(); ++i)
+    {
+        estado = t[estado + (unsigned char)bloque[i]];
+        if (estado == aceptacion && !sumidero.reportar(b.procesados + i + 1 - m))
+            return false;
+    }
+    b.estado = estado;
+    return true;
+}
+
+static bool alimentarRabinKarp(BuscadorFlujo &b, std::string_view bloque, SumideroResultados64 &sumidero)
+{
+    size_t m = b.patron.size();
+    const char *p = b.patron.data();
+    for (size_t i = 0; i < bloque.size(); ++i)
+    {
+        unsigned char c = bloque[i];
+        if (b.anillo.size() < m)
+        {
+            // Todavia llenando la primera ventana (no sale ningun byte)
+            b.anillo.push_back(c);
+            b.hashVentana = rodarHashRabinKarp(b.hashVentana, 0, c, b.potencia);
+            if (b.anillo.size() < m)
+                continue;
+        }
+        else
+        {
+            b.hashVentana = rodarHashRabinKarp(b.hashVentana, b.anillo[b.cabeza], c, b.potencia);
+            b.anillo[b.cabeza] = c;
+            b.cabeza = b.cabeza + 1 == m ? 0 : b.cabeza + 1;
+        }
+
+        // La ventana empieza en 'cabeza' y da la vuelta: se compara en dos tramos
+        if (b.hashVentana == b.hashPatron &&
+            std::memcmp(b.anillo.data() + b.cabeza, p, m - b.cabeza) == 0 &&
+            std::memcmp(b.anillo.data(), p + (m - b.cabeza), b.cabeza) == 0)
+        {
+            if (!sumidero.reportar(b.procesados + i + 1 - m))
+                return false;
+        }
+    }
+    return true;
+}
+
+bool alimentarBuscador(BuscadorFlujo &b, std::string_view bloque, SumideroResultados64 &sumidero)
+{
+    if (b.patron.empty())
+        return true;
+    bool seguir = true;
+    switch (b.algoritmo)
+    {
+    case AlgoritmoFlujo::KMP:
+        seguir = alimentarKMP(b, bloque, sumidero);
+        break;
+    case AlgoritmoFlujo::Automata:
+        seguir = alimentarAutomata(b, bloque, sumidero);
+        break;
+    case AlgoritmoFlujo::RabinKarp:
+        seguir = alimentarRabinKarp(b, bloque, sumidero);
+        break;
+    }
+    b.procesados += bloque.size();
+    return seguir;
+}
+
+void buscarEnCarpetaPorFlujo(const std::string &carpeta, std::string_view patron, AlgoritmoFlujo algoritmo,
+                             size_t tamBloque, SumideroResultados64 &sumidero, std::vector<Offset64> *cortes)
+{
+    if (cortes)
+        cortes->clear();
+    if (patron.empty())
+        return;
+
+    BuscadorFlujo buscador = crearBuscadorFlujo(patron, algoritmo);
+    recorrerCarpetaPorBloques(
+        carpeta, tamBloque,
+        [&](std::string_view bloque)
+        { return alimentarBuscador(buscador, bloque, sumidero); },
+        [&](const std::string &, uint64_t corte)
+        {
+            if (cortes)
+                cortes->push_back((Offset64)corte);
+        });
+}
+
+std::vector<Offset64> buscarEnCarpetaPorFlujo(const std::string &carpeta, std::string_view patron,
+                                              AlgoritmoFlujo algoritmo, size_t tamBloque,
+                                              std::vector<Offset64> *cortes)
+{
+    std::vector<Offset64> ocurrencias;
+    SumideroResultados64 sumidero = sumideroAgregar(ocurrencias);
+    buscarEnCarpetaPorFlujo(carpeta, patron, algoritmo, tamBloque, sumidero, cortes);
+    return ocurrencias;
+}
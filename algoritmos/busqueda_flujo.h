@@ -0,0 +1,69 @@
+#ifndef BUSQUEDA_FLUJO_H
+#define BUSQUEDA_FLUJO_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "resultados.h"
+
+// Algoritmos que pueden buscar sobre un flujo de bloques: su estado entre
+// bloques es pequeño (KMP: j, automata: estado, Rabin-Karp: hash y ventana)
+enum class AlgoritmoFlujo
+{
+    KMP,
+    Automata,
+    RabinKarp
+};
+
+// Buscador de un patron sobre texto que llega por bloques. Guarda entre
+// llamadas lo necesario para encontrar coincidencias que cruzan el borde de
+// un bloque, asi la memoria es O(m) sin importar el largo total del texto.
+struct BuscadorFlujo
+{
+    AlgoritmoFlujo algoritmo = AlgoritmoFlujo::KMP;
+    std::string patron;
+    uint64_t procesados = 0; // bytes ya recibidos (offset global del proximo)
+
+    // KMP
+    std::vector<int> lps;
+    int j = 0;
+
+    // Automata (estados premultiplicados por 256)
+    std::vector<int> tabla;
+    int estado = 0;
+
+    // Rabin-Karp: anillo con los ultimos m bytes y su hash
+    uint64_t hashPatron = 0, potencia = 1, hashVentana = 0;
+    std::string anillo;
+    size_t cabeza = 0; // posicion del byte mas antiguo de la ventana
+};
+
+// Prepara un buscador para 'patron' (que no debe ser vacio)
+BuscadorFlujo crearBuscadorFlujo(std::string_view patron, AlgoritmoFlujo algoritmo);
+
+// Procesa el siguiente bloque del flujo y reporta al sumidero, a medida que
+// aparece, el offset global (desde el inicio del flujo) de cada coincidencia que
+// termina en el bloque, en orden creciente. Devuelve false si el sumidero corto
+// la busqueda (el buscador queda a mitad del bloque: reiniciarlo para reusarlo).
+bool alimentarBuscador(BuscadorFlujo &buscador, std::string_view bloque, SumideroResultados64 &sumidero);
+
+// Vuelve al estado inicial (offset 0) conservando el patron preprocesado
+void reiniciarBuscador(BuscadorFlujo &buscador);
+
+// Busca 'patron' en los .txt de la carpeta leyendolos de a un archivo en bloques
+// de 'tamBloque' bytes (ver recorrerCarpetaPorBloques). Los offsets son los del
+// texto concatenado con '$', en 64 bits, y van al sumidero mientras se lee: con
+// Existe o PrimerosK se deja de leer la carpeta al cortar. En 'cortes' (si no es
+// nulo) quedan los cortes de los documentos leidos para ubicar las coincidencias.
+void buscarEnCarpetaPorFlujo(const std::string &carpeta, std::string_view patron, AlgoritmoFlujo algoritmo,
+                             size_t tamBloque, SumideroResultados64 &sumidero,
+                             std::vector<Offset64> *cortes = nullptr);
+
+// Igual, devolviendo todas las coincidencias
+std::vector<Offset64> buscarEnCarpetaPorFlujo(const std::string &carpeta, std::string_view patron,
+                                              AlgoritmoFlujo algoritmo, size_t tamBloque,
+                                              std::vector<Offset64> *cortes = nullptr);
+
+#endif
@@ -0,0 +1,101 @@
+#include "busqueda_paralela.h"
+#include "paralelo.h"
+#include <algorithm>
+#include <type_traits>
+
+// Tamaño minimo de un trozo: por debajo de esto no compensa lanzar hilos
+const size_t TAM_MIN_TROZO = 1 << 14;
+
+// Trozos por hilo, para repartir mejor la carga si algun trozo es mas lento
+const size_t TROZOS_POR_HILO = 4;
+
+// Tamaño maximo de un trozo: sus offsets locales siempre caben en Offset32
+const size_t TAM_MAX_TROZO = size_t(1) << 30;
+
+// Desplaza las posiciones locales de un trozo en 'desde' y las pasa al tipo de
+// offset final (con Offset32 se reutiliza el mismo vector)
+template <typename Offset>
+static std::vector<Offset> desplazar(std::vector<int> occ, size_t desde)
+{
+    if constexpr (std::is_same_v<Offset, int>)
+    {
+        for (int &pos : occ)
+            pos += desde;
+        return occ;
+    }
+    else
+    {
+        std::vector<Offset> result(occ.size());
+        for (size_t i = 0; i < occ.size(); ++i)
+            result[i] = (Offset)occ[i] + (Offset)desde;
+        return result;
+    }
+}
+
+template <typename Offset>
+std::vector<Offset> busquedaParalela(std::string_view text, std::string_view pattern,
+                                     FuncionBusqueda kernel, int hilos)
+{
+    verificarTamTexto<Offset>(text.size());
+    size_t n = text.size(), m = pattern.size();
+    if (m == 0 || n < m)
+        return {};
+    if (hilos < 1)
+        hilos = 1;
+
+    // Se reparten las posiciones de inicio [0, n - m] entre los trozos
+    size_t inicios = n - m + 1;
+    size_t tamTrozo = std::max(TAM_MIN_TROZO, (inicios + hilos * TROZOS_POR_HILO - 1) / (hilos * TROZOS_POR_HILO));
+    if (hilos == 1)
+        tamTrozo = inicios; // sin hilos extra: un solo trozo si cabe
+    tamTrozo = std::min(tamTrozo, TAM_MAX_TROZO - m);
+    size_t numTrozos = (inicios + tamTrozo - 1) / tamTrozo;
+    if (numTrozos <= 1)
+        return desplazar<Offset>(kernel(text, pattern), 0);
+
+    std::vector<std::vector<Offset>> parciales(numTrozos);
+    paraleloPara(numTrozos, hilos, [&](size_t t)
+                 {
+                     size_t desde = t * tamTrozo;
+                     size_t hasta = std::min(inicios, desde + tamTrozo);
+                     // El trozo incluye m-1 caracteres extra para las coincidencias del borde
+                     parciales[t] = desplazar<Offset>(kernel(text.substr(desde, hasta - desde + m - 1), pattern), desde); });
+
+    size_t total = 0;
+    for (const auto &p : parciales)
+        total += p.size();
+
+    std::vector<Offset> result;
+    result.reserve(total);
+    for (const auto &p : parciales)
+        result.insert(result.end(), p.begin(), p.end());
+    return result;
+}
+
+template <typename Offset>
+std::vector<std::vector<Offset>> busquedaLote(std::string_view text,
+                                              const std::vector<std::string> &patrones,
+                                              FuncionBusquedaT<Offset> kernel, int hilos)
+{
+    std::vector<std::vector<Offset>> resultados(patrones.size());
+    paraleloRobo(patrones.size(), hilos, [&](size_t i)
+                 { resultados[i] = kernel(text, patrones[i]); });
+    return resultados;
+}
+
+template <typename Offset>
+std::vector<std::vector<Offset>> busquedaLote(std::string_view text,
+                                              const std::vector<const PatronCompilado *> &compilados, int hilos)
+{
+    std::vector<std::vector<Offset>> resultados(compilados.size());
+    paraleloRobo(compilados.size(), hilos, [&](size_t i)
+                 { resultados[i] = buscarPatronCompilado<Offset>(*compilados[i], text); });
+    return resultados;
+}
+
+template std::vector<Offset32> busquedaParalela<Offset32>(std::string_view, std::string_view, FuncionBusqueda, int);
+template std::vector<Offset64> busquedaParalela<Offset64>(std::string_view, std::string_view, FuncionBusqueda, int);
+template std::vector<std::vector<Offset32>> busquedaLote<Offset32>(std::string_view, const std::vector<std::string> &, FuncionBusqueda, int);
+template std::vector<std::vector<Offset64>> busquedaLote<Offset64>(std::string_view, const std::vector<std::string> &, FuncionBusqueda64, int);
+template std::vector<std::vector<Offset32>> busquedaLote<Offset32>(std::string_view, const std::vector<const PatronCompilado *> &, int);
+template std::vector<std::vector<Offset64>> busquedaLote<Offset64>(std::string_view, const std::vector<const PatronCompilado *> &, int);
@@ -0,0 +1,39 @@
+#ifndef BUSQUEDA_PARALELA_H
+#define BUSQUEDA_PARALELA_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "resultados.h"
+#include "patron_compilado.h"
+
+// Firma comun de los algoritmos de un solo patron (kmpSearch, boyerMooreSearch, ...)
+template <typename Offset>
+using FuncionBusquedaT = std::vector<Offset> (*)(std::string_view text, std::string_view pattern);
+using FuncionBusqueda = FuncionBusquedaT<Offset32>;
+using FuncionBusqueda64 = FuncionBusquedaT<Offset64>;
+
+// Divide el texto en trozos que se solapan en m-1 caracteres y ejecuta 'kernel'
+// sobre cada trozo en hasta 'hilos' hilos. Cada trozo solo puede reportar
+// coincidencias que empiezan dentro de su propio rango, asi que al unir los
+// resultados en orden no hay duplicados en los bordes: el resultado es
+// identico al de kernel(text, pattern). Los trozos miden a lo sumo 1 GiB, asi
+// el kernel de 32 bits sirve aunque el texto completo necesite Offset64.
+template <typename Offset = Offset32>
+std::vector<Offset> busquedaParalela(std::string_view text, std::string_view pattern,
+                                     FuncionBusqueda kernel, int hilos);
+
+// Busca cada patron del lote con 'kernel' repartiendo los patrones en un pool
+// con robo de trabajo (un patron = una tarea). El resultado i corresponde a
+// patrones[i] y es identico a kernel(text, patrones[i]).
+template <typename Offset>
+std::vector<std::vector<Offset>> busquedaLote(std::string_view text,
+                                              const std::vector<std::string> &patrones,
+                                              FuncionBusquedaT<Offset> kernel, int hilos);
+
+// Igual, con patrones ya compilados: las tareas solo recorren el texto
+template <typename Offset>
+std::vector<std::vector<Offset>> busquedaLote(std::string_view text,
+                                              const std::vector<const PatronCompilado *> &compilados, int hilos);
+
+#endif
@@ -2,7 +2,7 @@
 #include <vector>
 #include <string>
 
-void buildLPS(const std::string &pattern, std::vector<int> &lps)
+void buildLPS(std::string_view pattern, std::vector<int> &lps)
 {
     int m = pattern.size();
     lps.assign(m, 0);
@@ -34,22 +34,23 @@ void buildLPS(const std::string &pattern, std::vector<int> &lps)
     }
 }
 
-std::vector<int> kmpSearch(const std::string &text, const std::string &pattern)
+PatronKMP construirPatronKMP(std::string_view pattern)
 {
-    // casos triviales
-    if (pattern.empty())
-        return {};
-    if (text.empty() || pattern.size() > text.size())
-        return {};
+    PatronKMP compilado;
+    compilado.patron = std::string(pattern);
+    buildLPS(pattern, compilado.lps);
+    return compilado;
+}
 
-    int n = (int)text.size();
+// Recorrido del texto con el lps ya calculado
+template <typename Offset>
+static void kmpNucleo(std::string_view text, std::string_view pattern, const int *lps, SumideroResultadosT<Offset> &sumidero)
+{
+    size_t n = text.size();
     int m = (int)pattern.size();
-    std::vector<int> lps;
-    buildLPS(pattern, lps);
 
-    std::vector<int> matches;
-    int i = 0; // indice para texto
-    int j = 0; // indice para patron
+    size_t i = 0; // indice para texto
+    int j = 0;    // indice para patron
 
     while (i < n)
     {
@@ -60,7 +61,8 @@ std::vector<int> kmpSearch(const std::string &text, const std::string &pattern)
             // si completamos el patron se registra la coincidencia
             if (j == m)
             {
-                matches.push_back(i - m);
+                if (!sumidero.reportar(i - m))
+                    return;
                 j = lps[j - 1]; // retrocedemos al valor previo del lps
             }
         }
@@ -78,5 +80,55 @@ std::vector<int> kmpSearch(const std::string &text, const std::string &pattern)
             }
         }
     }
+}
+
+template <typename Offset>
+void kmpSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero)
+{
+    verificarTamTexto<Offset>(text.size());
+    // casos triviales
+    if (pattern.empty())
+        return;
+    if (text.empty() || pattern.size() > text.size())
+        return;
+
+    std::vector<int> lps;
+    buildLPS(pattern, lps);
+    kmpNucleo(text, pattern, lps.data(), sumidero);
+}
+
+template <typename Offset>
+void kmpSearch(const PatronKMP &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero)
+{
+    verificarTamTexto<Offset>(text.size());
+    if (compilado.patron.empty() || compilado.patron.size() > text.size())
+        return;
+    kmpNucleo(text, compilado.patron, compilado.lps.data(), sumidero);
+}
+
+template <typename Offset>
+std::vector<Offset> kmpSearch(std::string_view text, std::string_view pattern)
+{
+    std::vector<Offset> matches;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(matches);
+    kmpSearch(text, pattern, sumidero);
+    return matches;
+}
+
+template <typename Offset>
+std::vector<Offset> kmpSearch(const PatronKMP &compilado, std::string_view text)
+{
+    std::vector<Offset> matches;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(matches);
+    kmpSearch(compilado, text, sumidero);
     return matches;
 }
+
+template std::vector<Offset32> kmpSearch<Offset32>(std::string_view, std::string_view);
+template std::vector<Offset64> kmpSearch<Offset64>(std::string_view, std::string_view);
+template void kmpSearch<Offset32>(std::string_view, std::string_view, SumideroResultados &);
+template void kmpSearch<Offset64>(std::string_view, std::string_view, SumideroResultados64 &);
+template std::vector<Offset32> kmpSearch<Offset32>(const PatronKMP &, std::string_view);
+template std::vector<Offset64> kmpSearch<Offset64>(const PatronKMP &, std::string_view);
+template void kmpSearch<Offset32>(const PatronKMP &, std::string_view, SumideroResultados &);
+template void kmpSearch<Offset64>(const PatronKMP &, std::string_view, SumideroResultados64 &);
@@ -3,8 +3,35 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include "resultados.h"
+
+// Tabla de prefijo-sufijo (lps) del patron: lps[i] es la longitud del borde
+// mas largo de pattern[0..i]
+void buildLPS(std::string_view pattern, std::vector<int> &lps);
+
+// Patron ya preprocesado: se construye una vez y se busca en muchos textos
+struct PatronKMP
+{
+    std::string patron;
+    std::vector<int> lps;
+};
+
+PatronKMP construirPatronKMP(std::string_view pattern);
 
 // Devuelve todos los offsets donde 'pattern' aparece en 'text'
-std::vector<int> kmpSearch(const std::string &text, const std::string &pattern);
+// (Offset32 por defecto; Offset64 para textos de mas de 2 GiB)
+template <typename Offset = Offset32>
+std::vector<Offset> kmpSearch(std::string_view text, std::string_view pattern);
+
+// Igual, pero entrega cada offset al sumidero (sin armar el vector)
+template <typename Offset>
+void kmpSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero);
+
+// Busqueda con el patron ya preprocesado (sin recalcular el lps)
+template <typename Offset = Offset32>
+std::vector<Offset> kmpSearch(const PatronKMP &compilado, std::string_view text);
+template <typename Offset>
+void kmpSearch(const PatronKMP &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero);
 
 #endif
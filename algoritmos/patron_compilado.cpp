@@ -0,0 +1,100 @@
+#include "patron_compilado.h"
+#include "simd.h"
+#include <type_traits>
+
+PatronCompilado compilarPatron(std::string_view patron, AlgoritmoPatron algoritmo)
+{
+    PatronCompilado compilado;
+    compilado.algoritmo = algoritmo;
+    switch (algoritmo)
+    {
+    case AlgoritmoPatron::KMP:
+        compilado.tablas = construirPatronKMP(patron);
+        break;
+    case AlgoritmoPatron::BoyerMoore:
+        compilado.tablas = construirPatronBoyerMoore(patron);
+        break;
+    case AlgoritmoPatron::Horspool:
+        compilado.tablas = construirPatronHorspool(patron);
+        break;
+    case AlgoritmoPatron::Sunday:
+        compilado.tablas = construirPatronSunday(patron);
+        break;
+    case AlgoritmoPatron::RabinKarp:
+        compilado.tablas = construirPatronRabinKarp(patron);
+        break;
+    case AlgoritmoPatron::Automata:
+        compilado.tablas = construirPatronAutomata(patron);
+        break;
+    case AlgoritmoPatron::SIMD:
+        compilado.tablas = std::string(patron);
+        break;
+    case AlgoritmoPatron::ShiftOr:
+        compilado.tablas = construirPatronShiftOr(patron);
+        break;
+    }
+    return compilado;
+}
+
+template <typename Offset>
+void buscarPatronCompilado(const PatronCompilado &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero)
+{
+    // La alternativa del variant ya identifica el algoritmo
+    std::visit([&](const auto &tablas)
+               {
+                   using T = std::decay_t<decltype(tablas)>;
+                   if constexpr (std::is_same_v<T, std::string>)
+                       simdSearch(text, tablas, sumidero);
+                   else if constexpr (std::is_same_v<T, PatronKMP>)
+                       kmpSearch(tablas, text, sumidero);
+                   else if constexpr (std::is_same_v<T, PatronBoyerMoore>)
+                       boyerMooreSearch(tablas, text, sumidero);
+                   else if constexpr (std::is_same_v<T, PatronHorspool>)
+                       horspoolSearch(tablas, text, sumidero);
+                   else if constexpr (std::is_same_v<T, PatronSunday>)
+                       sundaySearch(tablas, text, sumidero);
+                   else if constexpr (std::is_same_v<T, PatronRabinKarp>)
+                       rabinKarpSearch(tablas, text, sumidero);
+                   else if constexpr (std::is_same_v<T, PatronShiftOr>)
+                       shiftOrSearch(tablas, text, sumidero);
+                   else
+                       automataSearch(tablas, text, sumidero); },
+               compilado.tablas);
+}
+
+template <typename Offset>
+std::vector<Offset> buscarPatronCompilado(const PatronCompilado &compilado, std::string_view text)
+{
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    buscarPatronCompilado(compilado, text, sumidero);
+    return result;
+}
+
+const PatronCompilado &obtenerPatronCompilado(CachePatrones &cache, std::string_view patron, AlgoritmoPatron algoritmo)
+{
+    auto clave = std::make_pair(algoritmo, std::string(patron));
+    auto it = cache.compilados.find(clave);
+    if (it != cache.compilados.end())
+    {
+        cache.aciertos++;
+        return it->second;
+    }
+    cache.fallos++;
+    return cache.compilados.emplace(std::move(clave), compilarPatron(patron, algoritmo)).first->second;
+}
+
+std::vector<const PatronCompilado *> compilarConjunto(CachePatrones &cache, const std::vector<std::string> &patrones,
+                                                      AlgoritmoPatron algoritmo)
+{
+    std::vector<const PatronCompilado *> compilados;
+    compilados.reserve(patrones.size());
+    for (const auto &p : patrones)
+        compilados.push_back(&obtenerPatronCompilado(cache, p, algoritmo));
+    return compilados;
+}
+
+template std::vector<Offset32> buscarPatronCompilado<Offset32>(const PatronCompilado &, std::string_view);
+template std::vector<Offset64> buscarPatronCompilado<Offset64>(const PatronCompilado &, std::string_view);
+template void buscarPatronCompilado<Offset32>(const PatronCompilado &, std::string_view, SumideroResultados &);
+template void buscarPatronCompilado<Offset64>(const PatronCompilado &, std::string_view, SumideroResultados64 &);
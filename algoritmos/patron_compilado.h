@@ -0,0 +1,67 @@
+#ifndef PATRON_COMPILADO_H
+#define PATRON_COMPILADO_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <utility>
+#include <variant>
+#include <cstddef>
+#include "resultados.h"
+#include "kmp.h"
+#include "boyer_moore.h"
+#include "rabin_karp.h"
+#include "automata.h"
+#include "shift_or.h"
+
+// Algoritmos de un solo patron que se pueden compilar de antemano
+enum class AlgoritmoPatron
+{
+    KMP,
+    BoyerMoore,
+    Horspool,
+    Sunday,
+    RabinKarp,
+    Automata,
+    SIMD,
+    ShiftOr
+};
+
+// Patron compilado para un algoritmo: guarda sus tablas ya calculadas para
+// buscarlo en muchos textos o documentos sin repetir el preprocesamiento.
+// SIMD no tiene tablas (solo compara primer y ultimo byte), guarda el patron.
+struct PatronCompilado
+{
+    AlgoritmoPatron algoritmo = AlgoritmoPatron::KMP;
+    std::variant<PatronKMP, PatronBoyerMoore, PatronHorspool, PatronSunday,
+                 PatronRabinKarp, PatronAutomata, PatronShiftOr, std::string>
+        tablas;
+};
+
+PatronCompilado compilarPatron(std::string_view patron, AlgoritmoPatron algoritmo);
+
+// Busca el patron compilado en el texto con el algoritmo con el que se compilo
+template <typename Offset = Offset32>
+std::vector<Offset> buscarPatronCompilado(const PatronCompilado &compilado, std::string_view text);
+template <typename Offset>
+void buscarPatronCompilado(const PatronCompilado &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero);
+
+// Cache de patrones compilados, por (algoritmo, texto del patron). Cada patron
+// se compila la primera vez que se pide y despues se reutiliza; las
+// referencias devueltas siguen validas mientras viva la cache. No es segura
+// para usar desde varios hilos a la vez sin sincronizacion externa.
+struct CachePatrones
+{
+    std::map<std::pair<AlgoritmoPatron, std::string>, PatronCompilado> compilados;
+    size_t aciertos = 0;
+    size_t fallos = 0; // patrones que hubo que compilar
+};
+
+const PatronCompilado &obtenerPatronCompilado(CachePatrones &cache, std::string_view patron, AlgoritmoPatron algoritmo);
+
+// Compila (o toma de la cache) todos los patrones de un conjunto, en el mismo orden
+std::vector<const PatronCompilado *> compilarConjunto(CachePatrones &cache, const std::vector<std::string> &patrones,
+                                                      AlgoritmoPatron algoritmo);
+
+#endif
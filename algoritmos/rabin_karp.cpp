@@ -1,42 +1,277 @@
 #include "rabin_karp.h"
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <cstring>
+#include <map>
 
-const int d = 256;             // número de caracteres posibles (ASCII)
-const int q = 101;             // número primo para hashing (puedes cambiarlo)
+// Hash polinomial modulo el primo de Mersenne 2^61 - 1: con un modulo de ese
+// tamaño las colisiones son muy raras, y la reduccion es solo sumas y shifts.
+const uint64_t MOD = (1ULL << 61) - 1;
+const uint64_t BASE = 1000003; // base fija (> 256) para resultados reproducibles
 
-std::vector<int> rabinKarpSearch(const std::string& text, const std::string& pattern) {
-    std::vector<int> result;
-    int n = text.size();
-    int m = pattern.size();
+static inline uint64_t reducir(uint64_t x)
+{
+    x = (x & MOD) + (x >> 61);
+    return x >= MOD ? x - MOD : x;
+}
 
-    if (m == 0 || n < m) return result;
+// (a * b) mod 2^61-1, con a, b < 2^61 - 1
+static inline uint64_t mulMod(uint64_t a, uint64_t b)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 r = (unsigned __int128)a * b;
+    return reducir((uint64_t)(r & MOD) + (uint64_t)(r >> 61));
+#else
+    // Producto por mitades de 31 bits (sin enteros de 128 bits)
+    const uint64_t MASK30 = (1ULL << 30) - 1, MASK31 = (1ULL << 31) - 1;
+    uint64_t au = a >> 31, ad = a & MASK31;
+    uint64_t bu = b >> 31, bd = b & MASK31;
+    uint64_t mid = ad * bu + au * bd;
+    uint64_t midu = mid >> 30, midd = mid & MASK30;
+    return reducir(au * bu * 2 + midu + (midd << 31) + ad * bd);
+#endif
+}
 
-    int h = 1;
-    for (int i = 0; i < m - 1; i++)
-        h = (h * d) % q;
+static uint64_t hashBytes(const unsigned char *s, int m);
 
-    int p = 0;  // hash del patrón
-    int t = 0;  // hash del texto
+// h = BASE^(m-1) y hp = hash del patron: si no vienen precalculados (h == 0)
+// se obtienen aqui
+template <typename Offset>
+static void rabinKarpNucleo(std::string_view text, std::string_view pattern, uint64_t hp, uint64_t h,
+                            SumideroResultadosT<Offset> &sumidero, size_t *colisiones)
+{
+    verificarTamTexto<Offset>(text.size());
+    size_t falsos = 0;
+    size_t n = text.size();
+    int m = pattern.size();
 
-    // calcular hash inicial de patrón y ventana de texto
-    for (int i = 0; i < m; i++) {
-        p = (d * p + pattern[i]) % q;
-        t = (d * t + text[i]) % q;
+    if (m == 0 || n < (size_t)m)
+    {
+        if (colisiones)
+            *colisiones = 0;
+        return;
     }
 
+    const unsigned char *t = reinterpret_cast<const unsigned char *>(text.data());
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(pattern.data());
+
+    if (h == 0)
+    {
+        // h = BASE^(m-1): peso del caracter que sale de la ventana
+        h = 1;
+        for (int i = 0; i < m - 1; i++)
+            h = mulMod(h, BASE);
+        hp = hashBytes(p, m); // hash del patrón
+    }
+
+    // hash inicial de la ventana de texto (bytes sin signo)
+    uint64_t ht = hashBytes(t, m);
+
     // deslizar la ventana de texto
-    for (int i = 0; i <= n - m; i++) {
-        if (p == t) {
-            // posible coincidencia, verificar carácter por carácter
-            if (text.substr(i, m) == pattern)
-                result.push_back(i);
+    for (size_t i = 0; i <= n - m; i++)
+    {
+        if (hp == ht)
+        {
+            // posible coincidencia, verificar en el mismo texto (sin copias)
+            if (std::memcmp(t + i, p, m) != 0)
+                falsos++;
+            else if (!sumidero.reportar(i))
+                break;
+        }
+        if (i < n - m)
+        {
+            ht = reducir(ht + MOD - mulMod(t[i], h));
+            ht = reducir(mulMod(ht, BASE) + t[i + m]);
         }
-        if (i < n - m) {
-            t = (d * (t - text[i] * h) + text[i + m]) % q;
-            if (t < 0) t += q; // asegurarse de que el hash sea positivo
+    }
+
+    if (colisiones)
+        *colisiones = falsos;
+}
+
+template <typename Offset>
+std::vector<Offset> rabinKarpSearch(std::string_view text, std::string_view pattern, size_t *colisiones)
+{
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    rabinKarpNucleo(text, pattern, 0, 0, sumidero, colisiones);
+    return result;
+}
+
+template <typename Offset>
+std::vector<Offset> rabinKarpSearch(std::string_view text, std::string_view pattern)
+{
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    rabinKarpNucleo(text, pattern, 0, 0, sumidero, nullptr);
+    return result;
+}
+
+template <typename Offset>
+void rabinKarpSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero)
+{
+    rabinKarpNucleo(text, pattern, 0, 0, sumidero, nullptr);
+}
+
+template <typename Offset>
+void rabinKarpSearch(const PatronRabinKarp &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero)
+{
+    rabinKarpNucleo(text, compilado.patron, compilado.hash, compilado.potencia, sumidero, nullptr);
+}
+
+template <typename Offset>
+std::vector<Offset> rabinKarpSearch(const PatronRabinKarp &compilado, std::string_view text)
+{
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    rabinKarpSearch(compilado, text, sumidero);
+    return result;
+}
+
+template std::vector<Offset32> rabinKarpSearch<Offset32>(std::string_view, std::string_view);
+template std::vector<Offset64> rabinKarpSearch<Offset64>(std::string_view, std::string_view);
+template std::vector<Offset32> rabinKarpSearch<Offset32>(std::string_view, std::string_view, size_t *);
+template std::vector<Offset64> rabinKarpSearch<Offset64>(std::string_view, std::string_view, size_t *);
+template void rabinKarpSearch<Offset32>(std::string_view, std::string_view, SumideroResultados &);
+template void rabinKarpSearch<Offset64>(std::string_view, std::string_view, SumideroResultados64 &);
+template std::vector<Offset32> rabinKarpSearch<Offset32>(const PatronRabinKarp &, std::string_view);
+template std::vector<Offset64> rabinKarpSearch<Offset64>(const PatronRabinKarp &, std::string_view);
+template void rabinKarpSearch<Offset32>(const PatronRabinKarp &, std::string_view, SumideroResultados &);
+template void rabinKarpSearch<Offset64>(const PatronRabinKarp &, std::string_view, SumideroResultados64 &);
+
+// Casilla inicial de un hash en una tabla de tamaño potencia de 2: se mezclan
+// los bits altos porque el hash modular no reparte bien los bits bajos
+static inline int casillaHash(uint64_t hash, int mascara)
+{
+    return (int)((hash * 0x9E3779B97F4A7C15ULL) >> 32) & mascara;
+}
+
+static uint64_t hashBytes(const unsigned char *s, int m)
+{
+    uint64_t hash = 0;
+    for (int i = 0; i < m; i++)
+        hash = reducir(mulMod(hash, BASE) + s[i]);
+    return hash;
+}
+
+uint64_t hashRabinKarp(std::string_view s)
+{
+    return hashBytes(reinterpret_cast<const unsigned char *>(s.data()), (int)s.size());
+}
+
+uint64_t potenciaRabinKarp(int m)
+{
+    uint64_t h = 1;
+    for (int i = 0; i < m - 1; i++)
+        h = mulMod(h, BASE);
+    return h;
+}
+
+PatronRabinKarp construirPatronRabinKarp(std::string_view pattern)
+{
+    PatronRabinKarp compilado;
+    compilado.patron = std::string(pattern);
+    compilado.hash = hashRabinKarp(pattern);
+    compilado.potencia = potenciaRabinKarp((int)pattern.size());
+    return compilado;
+}
+
+uint64_t rodarHashRabinKarp(uint64_t hash, unsigned char sale, unsigned char entra, uint64_t potencia)
+{
+    hash = reducir(hash + MOD - mulMod(sale, potencia));
+    return reducir(mulMod(hash, BASE) + entra);
+}
+
+RabinKarpMulti construirRabinKarpMulti(const std::vector<std::string> &patrones)
+{
+    RabinKarpMulti rk;
+    rk.patrones = patrones;
+    rk.siguiente.assign(patrones.size(), -1);
+
+    // Ids de patrones por longitud (ordenadas de menor a mayor)
+    std::map<int, std::vector<int>> porLongitud;
+    for (size_t id = 0; id < patrones.size(); ++id)
+    {
+        if (!patrones[id].empty())
+            porLongitud[(int)patrones[id].size()].push_back((int)id);
+    }
+
+    for (const auto &[longitud, ids] : porLongitud)
+    {
+        GrupoRabinKarp g;
+        g.longitud = longitud;
+        g.potencia = potenciaRabinKarp(longitud);
+
+        int tam = 2;
+        while (tam < 2 * (int)ids.size())
+            tam <<= 1;
+        g.mascara = tam - 1;
+        g.hashes.assign(tam, 0);
+        g.primero.assign(tam, -1);
+
+        // Insertar en orden inverso para que la cadena de cada casilla quede
+        // con los ids en orden creciente
+        for (auto it = ids.rbegin(); it != ids.rend(); ++it)
+        {
+            int id = *it;
+            uint64_t hash = hashBytes(reinterpret_cast<const unsigned char *>(patrones[id].data()), longitud);
+            int c = casillaHash(hash, g.mascara);
+            while (g.primero[c] != -1 && g.hashes[c] != hash)
+                c = (c + 1) & g.mascara;
+            g.hashes[c] = hash;
+            rk.siguiente[id] = g.primero[c];
+            g.primero[c] = id;
         }
+        rk.grupos.push_back(std::move(g));
     }
+    return rk;
+}
+
+template <typename Offset>
+std::vector<std::pair<int, Offset>> rabinKarpMultiSearch(const RabinKarpMulti &rk, std::string_view text)
+{
+    verificarTamTexto<Offset>(text.size());
+    std::vector<std::pair<int, Offset>> result;
+    size_t n = text.size();
+    const unsigned char *t = reinterpret_cast<const unsigned char *>(text.data());
+
+    // Una pasada por longitud distinta, con un solo hash rodante
+    for (const GrupoRabinKarp &g : rk.grupos)
+    {
+        int m = g.longitud;
+        if (n < (size_t)m)
+            break; // los grupos siguientes son aun mas largos
 
+        const uint64_t *hashes = g.hashes.data();
+        const int *primero = g.primero.data();
+        uint64_t ht = hashBytes(t, m);
+        for (size_t i = 0; i <= n - m; i++)
+        {
+            int c = casillaHash(ht, g.mascara);
+            while (primero[c] != -1)
+            {
+                if (hashes[c] == ht)
+                {
+                    // Verificar cada patron de la casilla contra el texto
+                    for (int id = primero[c]; id != -1; id = rk.siguiente[id])
+                    {
+                        if (std::memcmp(t + i, rk.patrones[id].data(), m) == 0)
+                            result.emplace_back(id, (Offset)i);
+                    }
+                    break;
+                }
+                c = (c + 1) & g.mascara;
+            }
+            if (i < n - m)
+            {
+                ht = reducir(ht + MOD - mulMod(t[i], g.potencia));
+                ht = reducir(mulMod(ht, BASE) + t[i + m]);
+            }
+        }
+    }
     return result;
 }
+
+template std::vector<std::pair<int, Offset32>> rabinKarpMultiSearch<Offset32>(const RabinKarpMulti &, std::string_view);
+template std::vector<std::pair<int, Offset64>> rabinKarpMultiSearch<Offset64>(const RabinKarpMulti &, std::string_view);
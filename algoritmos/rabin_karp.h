@@ -2,9 +2,78 @@
 #define RABIN_KARP_H
 
 #include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
+#include <utility>
+#include "resultados.h"
 
 // Busca todas las ocurrencias de un patrón en el texto usando Rabin-Karp
-std::vector<int> rabinKarpSearch(const std::string& text, const std::string& pattern);
+// (hash rodante modulo 2^61 - 1, verificacion en el texto sin copias).
+// Offset32 por defecto; Offset64 para textos de mas de 2 GiB.
+template <typename Offset = Offset32>
+std::vector<Offset> rabinKarpSearch(std::string_view text, std::string_view pattern);
+
+// Igual, y deja en 'colisiones' (si no es nulo) la cantidad de ventanas cuyo
+// hash coincidio con el del patron sin ser una ocurrencia real (falsos positivos)
+template <typename Offset = Offset32>
+std::vector<Offset> rabinKarpSearch(std::string_view text, std::string_view pattern, size_t *colisiones);
+
+// Entrega cada offset al sumidero (sin armar el vector)
+template <typename Offset>
+void rabinKarpSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero);
+
+// Piezas del hash rodante (modulo 2^61 - 1), para quien mantenga su propia ventana:
+// hash de una cadena, peso BASE^(m-1) del byte que sale de una ventana de m, y
+// desplazamiento de la ventana un byte (sale 'sale', entra 'entra')
+uint64_t hashRabinKarp(std::string_view s);
+uint64_t potenciaRabinKarp(int m);
+uint64_t rodarHashRabinKarp(uint64_t hash, unsigned char sale, unsigned char entra, uint64_t potencia);
+
+// Patron ya preprocesado: su hash y el peso BASE^(m-1) se calculan una vez
+struct PatronRabinKarp
+{
+    std::string patron;
+    uint64_t hash = 0;
+    uint64_t potencia = 1;
+};
+
+PatronRabinKarp construirPatronRabinKarp(std::string_view pattern);
+
+template <typename Offset = Offset32>
+std::vector<Offset> rabinKarpSearch(const PatronRabinKarp &compilado, std::string_view text);
+template <typename Offset>
+void rabinKarpSearch(const PatronRabinKarp &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero);
+
+// Patrones de una misma longitud: sus hashes en una tabla de direccionamiento
+// abierto (sondeo lineal, tamaño potencia de 2, a lo sumo medio llena)
+struct GrupoRabinKarp
+{
+    int longitud = 0;
+    uint64_t potencia = 1;       // BASE^(longitud - 1), peso del byte que sale
+    int mascara = 0;             // tamaño de la tabla - 1
+    std::vector<uint64_t> hashes; // hash guardado en cada casilla
+    std::vector<int> primero;     // primer patron de la casilla (-1 = vacia)
+};
+
+// Rabin-Karp de multiples patrones: un hash rodante por longitud distinta, asi
+// el texto se recorre k veces (k = cantidad de longitudes) y no una por patron
+struct RabinKarpMulti
+{
+    std::vector<GrupoRabinKarp> grupos;
+    std::vector<int> siguiente;         // siguiente patron con el mismo hash (-1 = fin)
+    std::vector<std::string> patrones;  // copia de los patrones, para verificar
+};
+
+// Agrupa los patrones por longitud y arma la tabla de hashes de cada grupo
+// (los patrones vacios se ignoran)
+RabinKarpMulti construirRabinKarpMulti(const std::vector<std::string> &patrones);
+
+// Devuelve pares (id de patron, offset) por cada coincidencia, agrupados por
+// longitud de patron (de menor a mayor) y en orden creciente de offset dentro
+// de cada grupo
+template <typename Offset = Offset32>
+std::vector<std::pair<int, Offset>> rabinKarpMultiSearch(const RabinKarpMulti &rk, std::string_view text);
 
 #endif
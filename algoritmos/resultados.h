@@ -0,0 +1,110 @@
+#ifndef RESULTADOS_H
+#define RESULTADOS_H
+
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// Tipos de offset: 32 bits mientras el texto lo permita (arreglos mas densos
+// en cache) y 64 bits para textos de mas de 2 GiB. Las funciones con plantilla
+// sobre el offset se instancian para estos dos tipos.
+using Offset32 = int;
+using Offset64 = int64_t;
+
+// true si las posiciones de un texto de 'tamTexto' bytes no caben en Offset32
+inline bool necesitaOffset64(size_t tamTexto)
+{
+    return tamTexto > (size_t)INT32_MAX;
+}
+
+// Corta el programa si las posiciones de un texto de 'tamTexto' bytes no caben
+// en Offset: con Offset32 y mas de 2 GiB se truncarian sin aviso. Las entradas
+// con plantilla la llaman antes de buscar o construir; con Offset64 no hace nada.
+template <typename Offset>
+inline void verificarTamTexto(size_t tamTexto)
+{
+    if (sizeof(Offset) < sizeof(Offset64) && necesitaOffset64(tamTexto))
+    {
+        std::fprintf(stderr, "Error: texto de %zu bytes con offsets de 32 bits (usar Offset64, ver necesitaOffset64)\n",
+                     tamTexto);
+        std::abort();
+    }
+}
+
+// Que hace el sumidero con cada coincidencia
+enum class ModoResultado
+{
+    Contar,    // solo cuenta, sin memoria extra
+    PrimerosK, // guarda (si hay destino) las primeras 'limite' y corta la busqueda
+    Existe,    // corta en la primera coincidencia
+    Agregar    // agrega todas al vector del llamador
+};
+
+// Receptor de coincidencias que los algoritmos llaman dentro de su ciclo de
+// busqueda. No es virtual: 'reportar' es inline y el modo es un solo switch
+// que el predictor de saltos resuelve enseguida. En 'cuenta' quedan las
+// coincidencias reportadas (con corte anticipado, solo las vistas hasta cortar).
+template <typename Offset>
+struct SumideroResultadosT
+{
+    ModoResultado modo = ModoResultado::Contar;
+    size_t cuenta = 0;
+    size_t limite = 0;                      // k de PrimerosK (>= 1)
+    std::vector<Offset> *destino = nullptr; // PrimerosK (opcional) y Agregar
+
+    // Registra la coincidencia en 'pos'; devuelve false si la busqueda debe terminar
+    bool reportar(size_t pos)
+    {
+        ++cuenta;
+        switch (modo)
+        {
+        case ModoResultado::Contar:
+            return true;
+        case ModoResultado::Existe:
+            return false;
+        case ModoResultado::PrimerosK:
+            if (destino)
+                destino->push_back((Offset)pos);
+            return cuenta < limite;
+        case ModoResultado::Agregar:
+            destino->push_back((Offset)pos);
+            return true;
+        }
+        return true;
+    }
+
+    bool encontrado() const { return cuenta > 0; }
+};
+
+using SumideroResultados = SumideroResultadosT<Offset32>;
+using SumideroResultados64 = SumideroResultadosT<Offset64>;
+
+inline SumideroResultados sumideroContar()
+{
+    return {ModoResultado::Contar, 0, 0, nullptr};
+}
+
+inline SumideroResultados sumideroExiste()
+{
+    return {ModoResultado::Existe, 0, 0, nullptr};
+}
+
+template <typename Offset = Offset32>
+SumideroResultadosT<Offset> sumideroPrimeros(size_t k, std::vector<Offset> *destino = nullptr)
+{
+    return {ModoResultado::PrimerosK, 0, k, destino};
+}
+
+template <typename Offset>
+SumideroResultadosT<Offset> sumideroAgregar(std::vector<Offset> &destino)
+{
+    return {ModoResultado::Agregar, 0, 0, &destino};
+}
+
+// Firma comun de los algoritmos de un solo patron que reportan a un sumidero
+using FuncionBusquedaSumidero = void (*)(std::string_view text, std::string_view pattern, SumideroResultados &sumidero);
+
+#endif
@@ -0,0 +1,210 @@
+#include "shift_or.h"
+
+// Posicion del bit en 1 menos significativo (x != 0)
+static inline int bitMasBajo(uint64_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int b = 0;
+    while (!(x & 1))
+    {
+        x >>= 1;
+        ++b;
+    }
+    return b;
+#endif
+}
+
+// Mascaras del patron (m <= SHIFT_OR_MAX): todo en 1 salvo los bits de cada aparicion
+static void construirMascaras(std::string_view pattern, std::array<uint64_t, 256> &mascara)
+{
+    mascara.fill(~0ULL);
+    for (size_t j = 0; j < pattern.size(); ++j)
+    {
+        mascara[(unsigned char)pattern[j]] &= ~(1ULL << j);
+    }
+}
+
+// Recorre el texto con el estado en un solo registro
+template <typename Offset>
+static void shiftOrNucleo(std::string_view text, int m, const uint64_t *mascara, SumideroResultadosT<Offset> &sumidero)
+{
+    size_t n = text.size();
+    const unsigned char *t = reinterpret_cast<const unsigned char *>(text.data());
+    const uint64_t fin = 1ULL << (m - 1);
+    uint64_t estado = ~0ULL;
+    for (size_t i = 0; i < n; ++i)
+    {
+        estado = (estado << 1) | mascara[t[i]];
+        if (!(estado & fin) && !sumidero.reportar(i - m + 1))
+        {
+            return;
+        }
+    }
+}
+
+template <typename Offset>
+void shiftOrSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero)
+{
+    verificarTamTexto<Offset>(text.size());
+    if (pattern.empty() || text.size() < pattern.size())
+        return;
+    if (pattern.size() > (size_t)SHIFT_OR_MAX)
+    {
+        horspoolSearch(text, pattern, sumidero);
+        return;
+    }
+
+    std::array<uint64_t, 256> mascara;
+    construirMascaras(pattern, mascara);
+    shiftOrNucleo(text, (int)pattern.size(), mascara.data(), sumidero);
+}
+
+PatronShiftOr construirPatronShiftOr(std::string_view pattern)
+{
+    PatronShiftOr compilado;
+    compilado.patron = std::string(pattern);
+    if (pattern.size() > (size_t)SHIFT_OR_MAX)
+        compilado.respaldo = construirPatronHorspool(pattern);
+    else
+        construirMascaras(pattern, compilado.mascara);
+    return compilado;
+}
+
+template <typename Offset>
+void shiftOrSearch(const PatronShiftOr &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero)
+{
+    verificarTamTexto<Offset>(text.size());
+    size_t m = compilado.patron.size();
+    if (m == 0 || text.size() < m)
+        return;
+    if (m > (size_t)SHIFT_OR_MAX)
+    {
+        horspoolSearch(compilado.respaldo, text, sumidero);
+        return;
+    }
+    shiftOrNucleo(text, (int)m, compilado.mascara.data(), sumidero);
+}
+
+template <typename Offset>
+std::vector<Offset> shiftOrSearch(std::string_view text, std::string_view pattern)
+{
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    shiftOrSearch(text, pattern, sumidero);
+    return result;
+}
+
+template <typename Offset>
+std::vector<Offset> shiftOrSearch(const PatronShiftOr &compilado, std::string_view text)
+{
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    shiftOrSearch(compilado, text, sumidero);
+    return result;
+}
+
+ShiftOrMulti construirShiftOrMulti(const std::vector<std::string> &patrones)
+{
+    ShiftOrMulti so;
+    so.longitudes.resize(patrones.size());
+
+    // Primer ajuste: cada patron corto va a la primera palabra con lugar
+    std::vector<int> ocupados; // bits usados de cada palabra
+    std::vector<std::pair<int, int>> ubicacion(patrones.size(), {-1, 0}); // (palabra, bit inicial)
+    for (size_t id = 0; id < patrones.size(); ++id)
+    {
+        int m = patrones[id].size();
+        so.longitudes[id] = m;
+        if (m == 0)
+            continue;
+        if (m > SHIFT_OR_MAX)
+        {
+            so.idsLargos.push_back((int)id);
+            so.largos.push_back(construirPatronHorspool(patrones[id]));
+            continue;
+        }
+        size_t w = 0;
+        while (w < ocupados.size() && ocupados[w] + m > SHIFT_OR_MAX)
+            ++w;
+        if (w == ocupados.size())
+            ocupados.push_back(0);
+        ubicacion[id] = {(int)w, ocupados[w]};
+        ocupados[w] += m;
+    }
+
+    int W = ocupados.size();
+    so.numPalabras = W;
+    so.mascaras.assign(256 * (size_t)W, ~0ULL);
+    so.inicios.assign(W, 0);
+    so.finales.assign(W, 0);
+    so.idPorBit.assign(W * 64, -1);
+    for (size_t id = 0; id < patrones.size(); ++id)
+    {
+        auto [w, base] = ubicacion[id];
+        if (w < 0)
+            continue;
+        const std::string &p = patrones[id];
+        int m = p.size();
+        so.inicios[w] |= 1ULL << base;
+        so.finales[w] |= 1ULL << (base + m - 1);
+        so.idPorBit[w * 64 + base + m - 1] = (int)id;
+        for (int j = 0; j < m; ++j)
+            so.mascaras[(unsigned char)p[j] * (size_t)W + w] &= ~(1ULL << (base + j));
+    }
+    return so;
+}
+
+template <typename Offset>
+std::vector<std::pair<int, Offset>> shiftOrMultiSearch(const ShiftOrMulti &so, std::string_view text)
+{
+    verificarTamTexto<Offset>(text.size());
+    std::vector<std::pair<int, Offset>> result;
+    size_t n = text.size();
+    const unsigned char *t = reinterpret_cast<const unsigned char *>(text.data());
+    const int W = so.numPalabras;
+
+    if (W > 0)
+    {
+        std::vector<uint64_t> estado(W, ~0ULL);
+        const uint64_t *mascaras = so.mascaras.data();
+        const uint64_t *inicios = so.inicios.data();
+        const uint64_t *finales = so.finales.data();
+        for (size_t i = 0; i < n; ++i)
+        {
+            const uint64_t *fila = mascaras + t[i] * (size_t)W;
+            for (int w = 0; w < W; ++w)
+            {
+                uint64_t e = ((estado[w] << 1) & ~inicios[w]) | fila[w];
+                estado[w] = e;
+                uint64_t coincidencias = ~e & finales[w];
+                while (coincidencias)
+                {
+                    int b = bitMasBajo(coincidencias);
+                    coincidencias &= coincidencias - 1;
+                    int id = so.idPorBit[w * 64 + b];
+                    result.emplace_back(id, (Offset)(i + 1 - so.longitudes[id]));
+                }
+            }
+        }
+    }
+
+    for (size_t k = 0; k < so.largos.size(); ++k)
+    {
+        for (Offset pos : horspoolSearch<Offset>(so.largos[k], text))
+            result.emplace_back(so.idsLargos[k], pos);
+    }
+    return result;
+}
+
+template std::vector<Offset32> shiftOrSearch<Offset32>(std::string_view, std::string_view);
+template std::vector<Offset64> shiftOrSearch<Offset64>(std::string_view, std::string_view);
+template void shiftOrSearch<Offset32>(std::string_view, std::string_view, SumideroResultados &);
+template void shiftOrSearch<Offset64>(std::string_view, std::string_view, SumideroResultados64 &);
+template std::vector<Offset32> shiftOrSearch<Offset32>(const PatronShiftOr &, std::string_view);
+template std::vector<Offset64> shiftOrSearch<Offset64>(const PatronShiftOr &, std::string_view);
+template void shiftOrSearch<Offset32>(const PatronShiftOr &, std::string_view, SumideroResultados &);
+template void shiftOrSearch<Offset64>(const PatronShiftOr &, std::string_view, SumideroResultados64 &);
+template std::vector<std::pair<int, Offset32>> shiftOrMultiSearch<Offset32>(const ShiftOrMulti &, std::string_view);
+template std::vector<std::pair<int, Offset64>> shiftOrMultiSearch<Offset64>(const ShiftOrMulti &, std::string_view);
@@ -0,0 +1,72 @@
+#ifndef SHIFT_OR_H
+#define SHIFT_OR_H
+
+#include <string>
+#include <string_view>
+#include <array>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "resultados.h"
+#include "boyer_moore.h"
+
+// Largo maximo de patron que cabe en el registro de estado (una palabra de 64 bits)
+const int SHIFT_OR_MAX = 64;
+
+// Shift-Or (Bitap): el bit j del estado vale 0 si los ultimos j + 1 bytes
+// leidos coinciden con el prefijo de largo j + 1 del patron. Cada byte del
+// texto cuesta una consulta a la tabla, un desplazamiento y un or, sin
+// retrocesos. Patrones de mas de SHIFT_OR_MAX bytes se buscan con Horspool.
+// Offset32 por defecto; Offset64 para textos de mas de 2 GiB.
+template <typename Offset = Offset32>
+std::vector<Offset> shiftOrSearch(std::string_view text, std::string_view pattern);
+
+// Entrega cada offset al sumidero (sin armar el vector)
+template <typename Offset>
+void shiftOrSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero);
+
+// Patron ya preprocesado: mascara[c] tiene en 0 los bits j con pattern[j] == c.
+// Si el patron es largo solo se arma la tabla de Horspool del respaldo.
+struct PatronShiftOr
+{
+    std::string patron;
+    std::array<uint64_t, 256> mascara;
+    PatronHorspool respaldo; // solo para patrones de mas de SHIFT_OR_MAX bytes
+};
+
+PatronShiftOr construirPatronShiftOr(std::string_view pattern);
+
+template <typename Offset = Offset32>
+std::vector<Offset> shiftOrSearch(const PatronShiftOr &compilado, std::string_view text);
+template <typename Offset>
+void shiftOrSearch(const PatronShiftOr &compilado, std::string_view text, SumideroResultadosT<Offset> &sumidero);
+
+// Shift-Or de multiples patrones: los patrones cortos se empaquetan uno tras
+// otro en palabras de 64 bits (cada uno ocupa tantos bits como su largo) y el
+// texto se recorre una sola vez actualizando todas las palabras por byte. Tras
+// el desplazamiento se limpia el bit inicial de cada patron, para que el bit
+// final del patron anterior no se arrastre al siguiente.
+struct ShiftOrMulti
+{
+    int numPalabras = 0;
+    std::vector<uint64_t> mascaras; // mascaras[c * numPalabras + w]
+    std::vector<uint64_t> inicios;  // bit inicial de cada patron, por palabra
+    std::vector<uint64_t> finales;  // bit final de cada patron, por palabra
+    std::vector<int> idPorBit;      // id del patron que termina en el bit (w * 64 + b)
+    std::vector<int> longitudes;    // longitud de cada patron, por id
+
+    // Patrones de mas de SHIFT_OR_MAX bytes: se buscan aparte con Horspool
+    std::vector<int> idsLargos;
+    std::vector<PatronHorspool> largos;
+};
+
+// Empaqueta los patrones (primer ajuste, en orden) y arma las mascaras
+// (los patrones vacios se ignoran)
+ShiftOrMulti construirShiftOrMulti(const std::vector<std::string> &patrones);
+
+// Devuelve pares (id de patron, offset) por cada coincidencia, en el orden en
+// que terminan dentro del texto; las de patrones largos van al final
+template <typename Offset = Offset32>
+std::vector<std::pair<int, Offset>> shiftOrMultiSearch(const ShiftOrMulti &so, std::string_view text);
+
+#endif
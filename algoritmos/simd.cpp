@@ -0,0 +1,169 @@
+#include "simd.h"
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define SIMD_X86 1
+#include <emmintrin.h>
+#if defined(__GNUC__)
+#include <immintrin.h>
+#define SIMD_AVX2 1
+#endif
+#endif
+
+template <typename Offset>
+using FuncionSimd = void (*)(const char *t, size_t n, const char *p, int m, SumideroResultadosT<Offset> &sumidero);
+
+// Verifica los bytes interiores de un candidato (el primero y el ultimo ya coinciden)
+static inline bool verificarCentro(const char *t, const char *p, int m)
+{
+    return m <= 2 || std::memcmp(t + 1, p + 1, m - 2) == 0;
+}
+
+// Version escalar: mismo filtro primer/ultimo byte, una posicion a la vez
+template <typename Offset>
+static void buscarEscalar(const char *t, size_t n, const char *p, int m, SumideroResultadosT<Offset> &sumidero, size_t desde)
+{
+    const char primero = p[0], ultimo = p[m - 1];
+    for (size_t i = desde; i <= n - m; ++i)
+    {
+        if (t[i] == primero && t[i + m - 1] == ultimo && verificarCentro(t + i, p, m) && !sumidero.reportar(i))
+            return;
+    }
+}
+
+#ifndef SIMD_X86
+template <typename Offset>
+static void buscarEscalar(const char *t, size_t n, const char *p, int m, SumideroResultadosT<Offset> &sumidero)
+{
+    buscarEscalar(t, n, p, m, sumidero, 0);
+}
+#endif
+
+#ifdef SIMD_X86
+static int contarCerosFinales(unsigned int x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    int k = 0;
+    while (!(x & 1u))
+    {
+        x >>= 1;
+        ++k;
+    }
+    return k;
+#endif
+}
+
+template <typename Offset>
+static void buscarSSE2(const char *t, size_t n, const char *p, int m, SumideroResultadosT<Offset> &sumidero)
+{
+    const __m128i primero = _mm_set1_epi8(p[0]);
+    const __m128i ultimo = _mm_set1_epi8(p[m - 1]);
+
+    size_t i = 0;
+    for (; i + m - 1 + 16 <= n; i += 16)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(t + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(t + i + m - 1));
+        unsigned int mascara = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, primero), _mm_cmpeq_epi8(b, ultimo)));
+        while (mascara)
+        {
+            int k = contarCerosFinales(mascara);
+            if (verificarCentro(t + i + k, p, m) && !sumidero.reportar(i + k))
+                return;
+            mascara &= mascara - 1;
+        }
+    }
+    buscarEscalar(t, n, p, m, sumidero, i);
+}
+
+#ifdef SIMD_AVX2
+template <typename Offset>
+__attribute__((target("avx2"))) static void buscarAVX2(const char *t, size_t n, const char *p, int m, SumideroResultadosT<Offset> &sumidero)
+{
+    const __m256i primero = _mm256_set1_epi8(p[0]);
+    const __m256i ultimo = _mm256_set1_epi8(p[m - 1]);
+
+    size_t i = 0;
+    for (; i + m - 1 + 32 <= n; i += 32)
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(t + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(t + i + m - 1));
+        unsigned int mascara = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, primero), _mm256_cmpeq_epi8(b, ultimo)));
+        while (mascara)
+        {
+            int k = __builtin_ctz(mascara);
+            if (verificarCentro(t + i + k, p, m) && !sumidero.reportar(i + k))
+                return;
+            mascara &= mascara - 1;
+        }
+    }
+    buscarEscalar(t, n, p, m, sumidero, i);
+}
+#endif
+#endif
+
+struct ImplementacionSimd
+{
+    FuncionSimd<Offset32> buscar32;
+    FuncionSimd<Offset64> buscar64;
+    const char *nombre;
+};
+
+// Elige la mejor implementacion disponible en esta CPU
+static ImplementacionSimd elegirImplementacion()
+{
+#ifdef SIMD_X86
+#ifdef SIMD_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return {buscarAVX2<Offset32>, buscarAVX2<Offset64>, "AVX2"};
+#endif
+    return {buscarSSE2<Offset32>, buscarSSE2<Offset64>, "SSE2"};
+#else
+    return {buscarEscalar<Offset32>, buscarEscalar<Offset64>, "escalar"};
+#endif
+}
+
+// Se resuelve una sola vez, en el primer uso
+static const ImplementacionSimd &implementacion()
+{
+    static const ImplementacionSimd impl = elegirImplementacion();
+    return impl;
+}
+
+template <typename Offset>
+void simdSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero)
+{
+    verificarTamTexto<Offset>(text.size());
+    size_t n = text.size();
+    int m = pattern.size();
+    if (m == 0 || n < (size_t)m)
+        return;
+
+    if constexpr (std::is_same_v<Offset, Offset64>)
+        implementacion().buscar64(text.data(), n, pattern.data(), m, sumidero);
+    else
+        implementacion().buscar32(text.data(), n, pattern.data(), m, sumidero);
+}
+
+template <typename Offset>
+std::vector<Offset> simdSearch(std::string_view text, std::string_view pattern)
+{
+    std::vector<Offset> result;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(result);
+    simdSearch(text, pattern, sumidero);
+    return result;
+}
+
+template std::vector<Offset32> simdSearch<Offset32>(std::string_view, std::string_view);
+template std::vector<Offset64> simdSearch<Offset64>(std::string_view, std::string_view);
+template void simdSearch<Offset32>(std::string_view, std::string_view, SumideroResultados &);
+template void simdSearch<Offset64>(std::string_view, std::string_view, SumideroResultados64 &);
+
+const char *simdInstrucciones()
+{
+    return implementacion().nombre;
+}
@@ -0,0 +1,24 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <string>
+#include <string_view>
+#include "resultados.h"
+#include <vector>
+
+// Busqueda con filtro vectorial: compara el primer y el ultimo byte del patron
+// contra 16 (SSE2) o 32 (AVX2) posiciones del texto a la vez y solo verifica
+// las posiciones candidatas que coinciden en ambos. El juego de instrucciones
+// se elige en tiempo de ejecucion, con una version escalar de respaldo.
+// Offset32 por defecto; Offset64 para textos de mas de 2 GiB.
+template <typename Offset = Offset32>
+std::vector<Offset> simdSearch(std::string_view text, std::string_view pattern);
+
+// Igual, pero entrega cada offset al sumidero (sin armar el vector)
+template <typename Offset>
+void simdSearch(std::string_view text, std::string_view pattern, SumideroResultadosT<Offset> &sumidero);
+
+// Nombre del juego de instrucciones que usa simdSearch en esta maquina
+const char *simdInstrucciones();
+
+#endif
@@ -2,6 +2,12 @@
 #include <chrono>
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <filesystem>
+#include <tuple>
+#include <type_traits>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -12,11 +18,22 @@
 
 // Incluimos todos los headers de los algoritmos y estructuras
 #include "io.h"
+#include "paralelo.h"
 #include "kmp.h"
 #include "boyer_moore.h"
 #include "rabin_karp.h"
 #include "automata.h"
+#include "simd.h"
+#include "shift_or.h"
+#include "busqueda_aproximada.h"
+#include "aho_corasick.h"
+#include "busqueda_paralela.h"
+#include "busqueda_flujo.h"
 #include "suffix_array.h"
+#include "fm_index.h"
+#include "indice_persistente.h"
+#include "indice_segmentado.h"
+#include "sa_generalizado.h"
 
 using HRClock = std::chrono::high_resolution_clock;
 
@@ -37,8 +54,46 @@ size_t getMemoryKB()
     return 0;
 }
 
+#ifdef __linux__
+// Valor en KB de un campo de /proc/self/status (VmRSS:, VmHWM:)
+static size_t campoStatusKB(const std::string &campo)
+{
+    std::ifstream status("/proc/self/status");
+    std::string linea;
+    while (std::getline(status, linea))
+    {
+        if (linea.compare(0, campo.size(), campo) == 0)
+            return std::strtoull(linea.c_str() + campo.size(), nullptr, 10);
+    }
+    return 0;
+}
+#endif
+
+// Reinicia el pico de memoria del proceso y devuelve la memoria actual en KB.
+// En Linux el pico (VmHWM) se reinicia escribiendo 5 en /proc/self/clear_refs;
+// en otros sistemas no se puede y getMemoryPicoKB queda como referencia.
+size_t reiniciarMemoriaPicoKB()
+{
+#ifdef __linux__
+    std::ofstream("/proc/self/clear_refs") << "5";
+    return campoStatusKB("VmRSS:");
+#else
+    return getMemoryKB();
+#endif
+}
+
+size_t getMemoryPicoKB()
+{
+#ifdef __linux__
+    return campoStatusKB("VmHWM:");
+#else
+    return getMemoryKB();
+#endif
+}
+
 // Algoritmo 1: KMP
-void runKMP(const std::string &texto, const std::vector<std::string> &patrones)
+template <typename Offset>
+void runKMP(std::string_view texto, const std::vector<std::string> &patrones)
 {
     std::cout << "=== KMP ===\n";
     size_t mem_inicial = getMemoryKB();
@@ -47,7 +102,7 @@ void runKMP(const std::string &texto, const std::vector<std::string> &patrones)
     for (auto &p : patrones)
     {
         auto t0 = HRClock::now();
-        auto occ = kmpSearch(texto, p);
+        auto occ = kmpSearch<Offset>(texto, p);
         auto t1 = HRClock::now();
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
         std::cout << "  \"" << p << "\": " << occ.size() << " en " << ms << " ms\n";
@@ -60,7 +115,8 @@ void runKMP(const std::string &texto, const std::vector<std::string> &patrones)
 }
 
 // Algoritmo 2: Boyer-Moore
-void runBoyerMoore(const std::string &texto, const std::vector<std::string> &patrones)
+template <typename Offset>
+void runBoyerMoore(std::string_view texto, const std::vector<std::string> &patrones)
 {
     std::cout << "\n=== Boyer-Moore ===\n";
     size_t mem_inicial = getMemoryKB();
@@ -69,7 +125,31 @@ void runBoyerMoore(const std::string &texto, const std::vector<std::string> &pat
     for (const auto &p : patrones)
     {
         auto t0 = HRClock::now();
-        auto occ = boyerMooreSearch(texto, p);
+        auto occ = boyerMooreSearch<Offset>(texto, p);
+        auto t1 = HRClock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+        std::cout << "  \"" << p << "\": " << occ.size() << " ocurrencias en " << ms << " ms\n";
+    }
+
+    auto t1_total = HRClock::now();
+    size_t mem_final = getMemoryKB();
+    auto total_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_total - t0_total).count();
+    std::cout << "  Tiempo total: " << total_ms << " ms, Memoria extra: " << (mem_final - mem_inicial) << " KB\n";
+}
+
+// Variantes de Boyer-Moore y otros algoritmos de un solo patron con la firma comun
+template <typename Offset>
+void runAlgoritmo(const std::string &titulo, FuncionBusquedaT<Offset> kernel,
+                  std::string_view texto, const std::vector<std::string> &patrones)
+{
+    std::cout << "\n=== " << titulo << " ===\n";
+    size_t mem_inicial = getMemoryKB();
+    auto t0_total = HRClock::now();
+
+    for (const auto &p : patrones)
+    {
+        auto t0 = HRClock::now();
+        auto occ = kernel(texto, p);
         auto t1 = HRClock::now();
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
         std::cout << "  \"" << p << "\": " << occ.size() << " ocurrencias en " << ms << " ms\n";
@@ -82,29 +162,40 @@ void runBoyerMoore(const std::string &texto, const std::vector<std::string> &pat
 }
 
 // Algoritmo 3: Rabin-Karp
-void runRabinKarp(const std::string &texto, const std::vector<std::string> &patrones)
+template <typename Offset>
+void runRabinKarp(std::string_view texto, const std::vector<std::string> &patrones)
 {
     std::cout << "\n=== Rabin-Karp ===\n";
     size_t mem_inicial = getMemoryKB();
+    size_t total_colisiones = 0, total_ventanas = 0;
     auto t0_total = HRClock::now();
 
     for (const auto &p : patrones)
     {
         auto t0 = HRClock::now();
-        auto occ = rabinKarpSearch(texto, p);
+        size_t colisiones = 0;
+        auto occ = rabinKarpSearch<Offset>(texto, p, &colisiones);
         auto t1 = HRClock::now();
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
-        std::cout << "  \"" << p << "\": " << occ.size() << " ocurrencias en " << ms << " ms\n";
+
+        // Tasa de falsos positivos: colisiones de hash por ventana del texto
+        size_t ventanas = texto.size() >= p.size() ? texto.size() - p.size() + 1 : 0;
+        total_colisiones += colisiones;
+        total_ventanas += ventanas;
+        std::cout << "  \"" << p << "\": " << occ.size() << " ocurrencias en " << ms << " ms, "
+                  << colisiones << " colisiones (" << (ventanas ? 100.0 * colisiones / ventanas : 0.0) << "%)\n";
     }
 
     auto t1_total = HRClock::now();
     size_t mem_final = getMemoryKB();
     auto total_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_total - t0_total).count();
     std::cout << "  Tiempo total: " << total_ms << " ms, Memoria extra: " << (mem_final - mem_inicial) << " KB\n";
+    std::cout << "  Falsos positivos: " << total_colisiones << " de " << total_ventanas << " ventanas\n";
 }
 
 // EXTRA: Algoritmo 4: DFA(Automata Finito Determinista)
-void runAutomata(const std::string &texto, const std::vector<std::string> &patrones)
+template <typename Offset>
+void runAutomata(std::string_view texto, const std::vector<std::string> &patrones)
 {
     std::cout << "\n=== Automata Finito ===\n";
     size_t mem_inicial = getMemoryKB();
@@ -113,7 +204,7 @@ void runAutomata(const std::string &texto, const std::vector<std::string> &patro
     for (const auto &p : patrones)
     {
         auto t0 = HRClock::now();
-        auto occ = automataSearch(texto, p);
+        auto occ = automataSearch<Offset>(texto, p);
         auto t1 = HRClock::now();
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
         std::cout << "  \"" << p << "\": " << occ.size() << " ocurrencias en " << ms << " ms\n";
@@ -125,33 +216,187 @@ void runAutomata(const std::string &texto, const std::vector<std::string> &patro
     std::cout << "  Tiempo total: " << total_ms << " ms, Memoria extra: " << (mem_final - mem_inicial) << " KB\n";
 }
 
+// EXTRA: Algoritmo SIMD (filtro vectorial de primer/ultimo byte)
+template <typename Offset>
+void runSIMD(std::string_view texto, const std::vector<std::string> &patrones)
+{
+    std::cout << "\n=== SIMD (" << simdInstrucciones() << ") ===\n";
+    size_t mem_inicial = getMemoryKB();
+    auto t0_total = HRClock::now();
+
+    for (const auto &p : patrones)
+    {
+        auto t0 = HRClock::now();
+        auto occ = simdSearch<Offset>(texto, p);
+        auto t1 = HRClock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+        std::cout << "  \"" << p << "\": " << occ.size() << " ocurrencias en " << ms << " ms\n";
+    }
+
+    auto t1_total = HRClock::now();
+    size_t mem_final = getMemoryKB();
+    auto total_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_total - t0_total).count();
+    std::cout << "  Tiempo total: " << total_ms << " ms, Memoria extra: " << (mem_final - mem_inicial) << " KB\n";
+}
+
+// EXTRA: Algoritmo 5: Aho-Corasick (todos los patrones en una sola pasada)
+template <typename Offset>
+void runAhoCorasick(std::string_view texto, const std::vector<std::string> &patrones)
+{
+    std::cout << "\n=== Aho-Corasick ===\n";
+    size_t mem_inicial = getMemoryKB();
+
+    auto t0_build = HRClock::now();
+    AhoCorasick ac = construirAhoCorasick(patrones);
+    auto t1_build = HRClock::now();
+    auto build_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_build - t0_build).count();
+    std::cout << "  Tiempo construccion: " << build_ms << " ms\n";
+
+    auto t0_total = HRClock::now();
+    auto occ = ahoCorasickSearch<Offset>(ac, texto);
+    auto t1_total = HRClock::now();
+
+    // Contar ocurrencias por patron
+    std::vector<int> conteo(patrones.size(), 0);
+    for (const auto &[id, pos] : occ)
+    {
+        conteo[id]++;
+    }
+    for (size_t i = 0; i < patrones.size(); ++i)
+    {
+        std::cout << "  \"" << patrones[i] << "\": " << conteo[i] << " ocurrencias\n";
+    }
+
+    size_t mem_final = getMemoryKB();
+    auto total_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_total - t0_total).count();
+    std::cout << "  Tiempo total (una pasada): " << total_ms << " ms, Memoria extra: " << (mem_final - mem_inicial) << " KB\n";
+}
+
+// Rabin-Karp multipatron: una pasada por cada longitud distinta de patron
+template <typename Offset>
+void runRabinKarpMulti(std::string_view texto, const std::vector<std::string> &patrones)
+{
+    std::cout << "\n=== Rabin-Karp multipatron ===\n";
+    size_t mem_inicial = getMemoryKB();
+
+    auto t0_build = HRClock::now();
+    RabinKarpMulti rk = construirRabinKarpMulti(patrones);
+    auto t1_build = HRClock::now();
+    auto build_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_build - t0_build).count();
+    std::cout << "  Tiempo construccion: " << build_ms << " ms (" << rk.grupos.size() << " longitudes distintas)\n";
+
+    auto t0_total = HRClock::now();
+    auto occ = rabinKarpMultiSearch<Offset>(rk, texto);
+    auto t1_total = HRClock::now();
+
+    // Contar ocurrencias por patron
+    std::vector<int> conteo(patrones.size(), 0);
+    for (const auto &[id, pos] : occ)
+    {
+        conteo[id]++;
+    }
+    for (size_t i = 0; i < patrones.size(); ++i)
+    {
+        std::cout << "  \"" << patrones[i] << "\": " << conteo[i] << " ocurrencias\n";
+    }
+
+    size_t mem_final = getMemoryKB();
+    auto total_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_total - t0_total).count();
+    std::cout << "  Tiempo total (" << rk.grupos.size() << " pasadas): " << total_ms << " ms, Memoria extra: " << (mem_final - mem_inicial) << " KB\n";
+}
+
+// Shift-Or multipatron: los patrones cortos empaquetados en palabras de 64 bits
+template <typename Offset>
+void runShiftOrMulti(std::string_view texto, const std::vector<std::string> &patrones)
+{
+    std::cout << "\n=== Shift-Or multipatron ===\n";
+    size_t mem_inicial = getMemoryKB();
+
+    auto t0_build = HRClock::now();
+    ShiftOrMulti so = construirShiftOrMulti(patrones);
+    auto t1_build = HRClock::now();
+    auto build_us = std::chrono::duration_cast<std::chrono::microseconds>(t1_build - t0_build).count();
+    std::cout << "  Tiempo construccion: " << build_us << " us (" << so.numPalabras << " palabras de 64 bits, "
+              << so.largos.size() << " patrones largos)\n";
+
+    auto t0_total = HRClock::now();
+    auto occ = shiftOrMultiSearch<Offset>(so, texto);
+    auto t1_total = HRClock::now();
+
+    std::vector<int> conteo(patrones.size(), 0);
+    for (const auto &[id, pos] : occ)
+    {
+        conteo[id]++;
+    }
+    for (size_t i = 0; i < patrones.size(); ++i)
+    {
+        std::cout << "  \"" << patrones[i] << "\": " << conteo[i] << " ocurrencias\n";
+    }
+
+    size_t mem_final = getMemoryKB();
+    auto total_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_total - t0_total).count();
+    std::cout << "  Tiempo total (1 pasada): " << total_ms << " ms, Memoria extra: " << (mem_final - mem_inicial) << " KB\n";
+}
+
 // Estructura 1: Suffix Array
-void runSuffixArray(const std::string &texto, const std::vector<std::string> &patrones)
+template <typename Offset>
+void runSuffixArray(std::string_view texto, const std::vector<std::string> &patrones)
 {
     std::cout << "\n=== Suffix Array ===\n";
     size_t mem_inicial = getMemoryKB();
 
     // Medir tiempo de construccion
     auto t0_build = HRClock::now();
-    std::vector<int> suffixArray = construirSuffixArray(texto);
+    std::vector<Offset> suffixArray = construirSuffixArray<Offset>(texto);
     auto t1_build = HRClock::now();
     auto build_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_build - t0_build).count();
     size_t mem_construccion = getMemoryKB();
-    std::cout << "  Tiempo construccion: " << build_ms << " ms\n";
+    std::cout << "  Tiempo construccion (SA-IS): " << build_ms << " ms\n";
     std::cout << "  Memoria construccion: " << (mem_construccion - mem_inicial) << " KB\n";
 
+    // Constructor anterior, solo como referencia
+    auto t0_dup = HRClock::now();
+    std::vector<Offset> suffixArrayDup = construirSuffixArray<Offset>(texto, MetodoSA::Duplicacion);
+    auto t1_dup = HRClock::now();
+    auto dup_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_dup - t0_dup).count();
+    std::cout << "  Tiempo construccion (duplicacion): " << dup_ms << " ms"
+              << (suffixArrayDup == suffixArray ? "" : " (DIFIERE de SA-IS!)") << "\n";
+
+    // Mismo SA con offsets de 64 bits (lo que se usaria con un corpus de mas de 2 GiB);
+    // si el corpus ya los necesita, el SA de arriba es ese
+    if constexpr (std::is_same_v<Offset, Offset32>)
+    {
+        size_t mem_64 = getMemoryKB();
+        auto t0_64 = HRClock::now();
+        std::vector<Offset64> suffixArray64 = construirSuffixArray<Offset64>(texto);
+        auto t1_64 = HRClock::now();
+        auto ms_64 = std::chrono::duration_cast<std::chrono::milliseconds>(t1_64 - t0_64).count();
+        bool iguales64 = std::equal(suffixArray.begin(), suffixArray.end(), suffixArray64.begin(), suffixArray64.end());
+        std::cout << "  Tiempo construccion (SA-IS, 64 bits): " << ms_64 << " ms, " << suffixArray64.size() * sizeof(Offset64) / 1024
+                  << " KB vs " << suffixArray.size() * sizeof(Offset32) / 1024 << " KB con 32 bits, Memoria extra: "
+                  << (getMemoryKB() - mem_64) << " KB" << (iguales64 ? "" : " (DIFIERE!)") << "\n";
+        std::vector<Offset64>().swap(suffixArray64);
+    }
+
+    // Arreglo LCP (Kasai) para acelerar las consultas
+    auto t0_lcp = HRClock::now();
+    LCPBusquedaT<Offset> lcp = construirLCPBusqueda(construirLCP(texto, suffixArray));
+    auto t1_lcp = HRClock::now();
+    auto lcp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_lcp - t0_lcp).count();
+    std::cout << "  Tiempo construccion LCP: " << lcp_ms << " ms\n";
+
     // Buscar cada patron
     auto t0_total = HRClock::now();
     for (const auto &p : patrones)
     {
         auto t0 = HRClock::now();
-        auto occs = buscarConSuffixArray(texto, p, suffixArray);
+        auto occs = buscarConSuffixArray(texto, p, suffixArray, lcp);
         auto t1 = HRClock::now();
 
         auto us = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
         std::cout << "  Patron \"" << p << "\": " << occs.size() << " ocurrencias en " << us << " ms\n";
 
-        for (int pos : occs)
+        for (Offset pos : occs)
         {
             std::cout << "    Posicion: " << pos << "\n";
         }
@@ -164,28 +409,521 @@ void runSuffixArray(const std::string &texto, const std::vector<std::string> &pa
     std::cout << "  Memoria total: " << (mem_final - mem_inicial) << " KB\n";
 }
 
+// Estructura 2: FM-index. Con distintos pasos de muestreo del SA: menos
+// memoria a cambio de ubicar mas lento (contar no depende del muestreo)
+template <typename Offset>
+void runFMIndex(std::string_view texto, const std::vector<std::string> &patrones)
+{
+    std::cout << "\n=== FM-index (BWT + wavelet matrix) ===\n";
+    size_t bytesSA = texto.size() * sizeof(Offset);
+    std::cout << "  Referencia: texto " << texto.size() / 1024 << " KB + SA " << bytesSA / 1024 << " KB\n";
+
+    for (int paso : {4, 32, 128})
+    {
+        auto t0_build = HRClock::now();
+        FMIndexT<Offset> fm = construirFMIndex<Offset>(texto, paso);
+        auto t1_build = HRClock::now();
+        auto build_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_build - t0_build).count();
+        std::cout << "  Muestreo cada " << paso << ": construccion " << build_ms << " ms, indice "
+                  << bytesFMIndex(fm) / 1024 << " KB (" << (double)bytesFMIndex(fm) / std::max<size_t>(1, texto.size())
+                  << " bytes por caracter, sin el texto)\n";
+
+        for (const auto &p : patrones)
+        {
+            auto t0 = HRClock::now();
+            size_t cuenta = contarConFMIndex(fm, p);
+            auto t1 = HRClock::now();
+            auto occs = buscarConFMIndex(fm, p);
+            auto t2 = HRClock::now();
+            auto contar_us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+            auto ubicar_us = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+            std::cout << "    Patron \"" << p << "\": " << cuenta << " ocurrencias, contar " << contar_us
+                      << " us, ubicar " << ubicar_us << " us"
+                      << (occs.size() == kmpSearch<Offset>(texto, p).size() ? "" : " (DIFIERE de KMP)") << "\n";
+        }
+    }
+}
+
+// Estructura 3: Suffix Array persistente (indice mapeado desde disco, sin reconstruir)
+void runIndiceMapeado(const std::string &carpeta, const std::string &rutaIndice, const std::vector<std::string> &patrones)
+{
+    std::cout << "\n=== Indice persistente (mmap) ===\n";
+
+    auto t0_carga = HRClock::now();
+    IndiceMapeado indice;
+    bool cargado = cargarIndice(rutaIndice, indice);
+    auto t1_carga = HRClock::now();
+    if (!cargado)
+    {
+        std::cout << "  No se encontro el indice " << rutaIndice << " (generarlo con bin/indexador)\n";
+        return;
+    }
+    if (indice.checksum != checksumCorpus(carpeta))
+    {
+        std::cout << "  Aviso: el indice no corresponde al corpus actual\n";
+    }
+    auto carga_us = std::chrono::duration_cast<std::chrono::microseconds>(t1_carga - t0_carga).count();
+    std::cout << "  Tiempo carga: " << carga_us << " us (" << indice.texto.size() << " caracteres, offsets de "
+              << (indice.offset64 ? 64 : 32) << " bits)\n";
+
+    auto t0_total = HRClock::now();
+    for (const auto &p : patrones)
+    {
+        auto t0 = HRClock::now();
+        size_t ocurrencias = indice.offset64
+                                 ? buscarConSuffixArray(indice.texto, p, indice.a64.sa, indice.a64.lcpIzq, indice.a64.lcpDer).size()
+                                 : buscarConSuffixArray(indice.texto, p, indice.a32.sa, indice.a32.lcpIzq, indice.a32.lcpDer).size();
+        auto t1 = HRClock::now();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+        std::cout << "  Patron \"" << p << "\": " << ocurrencias << " ocurrencias en " << us << " us\n";
+    }
+    auto t1_total = HRClock::now();
+    auto total_us = std::chrono::duration_cast<std::chrono::microseconds>(t1_total - t0_total).count();
+    std::cout << "  Tiempo busqueda: " << total_us << " us\n";
+}
+
+// Indice segmentado: el corpus llega en lotes de documentos, cada lote arma su
+// propio segmento; se compara contra reconstruir el SA completo en cada lote
+template <typename Offset>
+void runIndiceSegmentado(const Corpus &corpus, const std::vector<std::string> &patrones)
+{
+    std::cout << "\n=== Indice segmentado (lotes incrementales) ===\n";
+    const size_t DOCS_POR_LOTE = 5;
+    std::string_view texto = corpus.texto();
+
+    // Los lotes se agregan y consultan mientras el hilo de compactacion fusiona
+    // segmentos en segundo plano; cada consulta se compara con KMP sobre lo recibido
+    IndiceSegmentado indice;
+    iniciarCompactacion(indice);
+    double agregar_us = 0, reconstruir_us = 0;
+    size_t maxSegmentos = 0, consultas = 0, diferencias = 0;
+    for (size_t d = 0; d < corpus.nombres.size(); d += DOCS_POR_LOTE)
+    {
+        std::vector<std::string> nombres, contenidos;
+        for (size_t i = d; i < std::min(d + DOCS_POR_LOTE, corpus.nombres.size()); ++i)
+        {
+            int64_t inicio = i == 0 ? 0 : corpus.cortes[i - 1];
+            nombres.push_back(corpus.nombres[i]);
+            contenidos.push_back(std::string(texto.substr(inicio, corpus.cortes[i] - 1 - inicio)));
+        }
+        auto t0 = HRClock::now();
+        agregarDocumentos(indice, nombres, contenidos);
+        auto t1 = HRClock::now();
+        agregar_us += std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+        maxSegmentos = std::max(maxSegmentos, numSegmentos(indice));
+
+        std::string_view recibido = texto.substr(0, corpus.cortes[d + nombres.size() - 1]);
+        for (const auto &p : patrones)
+        {
+            consultas++;
+            diferencias += buscarEnIndiceSegmentado(indice, p).size() != kmpSearch<Offset>(recibido, p).size();
+        }
+
+        // Alternativa sin segmentos: SA + LCP de todo lo recibido hasta ahora
+        t0 = HRClock::now();
+        auto sa = construirSuffixArray<Offset>(recibido);
+        auto lcp = construirLCPBusqueda(construirLCP(recibido, sa));
+        t1 = HRClock::now();
+        reconstruir_us += std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+    }
+    std::cout << "  Lotes de " << DOCS_POR_LOTE << " documentos: agregar " << agregar_us << " us, reconstruir SA completo "
+              << reconstruir_us << " us\n";
+    std::cout << "  Compactacion en segundo plano: hasta " << maxSegmentos << " segmentos, ahora " << numSegmentos(indice)
+              << " tras " << numCompactaciones(indice) << " compactaciones; " << consultas
+              << " consultas durante la carga" << (diferencias ? " (" + std::to_string(diferencias) + " DIFIEREN de KMP)" : "")
+              << "\n";
+
+    for (const auto &p : patrones)
+    {
+        auto t0 = HRClock::now();
+        size_t ocurrencias = buscarEnIndiceSegmentado(indice, p).size();
+        auto t1 = HRClock::now();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+        std::cout << "  Patron \"" << p << "\": " << ocurrencias << " ocurrencias en " << us << " us"
+                  << (ocurrencias == kmpSearch<Offset>(texto, p).size() ? "" : " (DIFIERE de KMP)") << "\n";
+    }
+
+    // Borrar dos de cada tres documentos (lapidas) y consultar con el hilo
+    // todavia activo; al detenerlo, lo que quede por compactar se hace en este hilo
+    size_t antes = numSegmentos(indice), compactacionesAntes = numCompactaciones(indice), borrados = 0;
+    for (size_t i = 0; i < corpus.nombres.size(); ++i)
+    {
+        if (i % 3 == 0)
+            continue;
+        borrados += eliminarDocumento(indice, corpus.nombres[i]);
+        for (const auto &p : patrones)
+            buscarEnIndiceSegmentado(indice, p);
+    }
+    auto t0 = HRClock::now();
+    detenerCompactacion(indice);
+    size_t enSegundoPlano = numCompactaciones(indice) - compactacionesAntes;
+    while (compactarSegmentos(indice))
+    {
+    }
+    auto t1 = HRClock::now();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+    std::cout << "  Borrados " << borrados << " documentos; compactacion: " << antes << " -> "
+              << numSegmentos(indice) << " segmentos (" << enSegundoPlano << " en segundo plano, "
+              << numCompactaciones(indice) - compactacionesAntes - enSegundoPlano << " al detener, " << us
+              << " us) con " << numDocumentosVigentes(indice) << " documentos vigentes\n";
+
+    // Despues de compactar solo deben quedar las coincidencias de los documentos vigentes
+    for (const auto &p : patrones)
+    {
+        size_t esperadas = 0;
+        for (size_t i = 0; i < corpus.nombres.size(); i += 3)
+        {
+            int64_t inicio = i == 0 ? 0 : corpus.cortes[i - 1];
+            esperadas += kmpSearch<Offset>(texto.substr(inicio, corpus.cortes[i] - 1 - inicio), p).size();
+        }
+        if (buscarEnIndiceSegmentado(indice, p).size() != esperadas)
+            std::cout << "  Patron \"" << p << "\": DIFIERE de KMP tras borrar y compactar\n";
+    }
+}
+
+// Sincronizacion con una carpeta: una copia temporal del corpus se indexa con
+// sincronizarCarpeta y se vuelve a sincronizar sin cambios y tras modificar,
+// borrar y agregar un documento (solo se leen los archivos que cambiaron)
+template <typename Offset>
+void runSincronizacionCarpeta(const std::string &carpeta, const std::vector<std::string> &patrones)
+{
+    std::cout << "\n=== Indice segmentado: sincronizacion con la carpeta ===\n";
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::path copia = fs::temp_directory_path(ec) / "bench_sincronizacion";
+    fs::remove_all(copia, ec);
+    fs::create_directories(copia, ec);
+    std::vector<fs::path> archivos;
+    for (const auto &entry : fs::directory_iterator(carpeta, ec))
+    {
+        if (entry.path().extension() == ".txt")
+            archivos.push_back(entry.path());
+    }
+    std::sort(archivos.begin(), archivos.end());
+    for (const auto &ruta : archivos)
+        fs::copy_file(ruta, copia / ruta.filename(), ec);
+    if (ec || archivos.size() < 2)
+    {
+        std::cout << "  No se pudo preparar la copia en " << copia << "\n";
+        fs::remove_all(copia, ec);
+        return;
+    }
+
+    IndiceSegmentado indice;
+    auto sincronizar = [&](const char *paso)
+    {
+        auto t0 = HRClock::now();
+        size_t cambios = sincronizarCarpeta(indice, copia.string());
+        auto t1 = HRClock::now();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+        std::cout << "  " << paso << ": " << cambios << " cambios en " << us << " us (" << numDocumentosVigentes(indice)
+                  << " documentos, " << numSegmentos(indice) << " segmentos)\n";
+    };
+    sincronizar("Carga inicial");
+    sincronizar("Sin cambios");
+
+    // Modificar el primero, borrar el segundo y agregar uno nuevo: 3 cambios
+    std::ofstream(copia / archivos[0].filename(), std::ios::app) << "\n" << patrones[0] << "\n";
+    fs::remove(copia / archivos[1].filename(), ec);
+    std::ofstream(copia / "bench_nuevo.txt") << patrones[0] << " " << patrones[0] << "\n";
+    sincronizar("Modificar, borrar y agregar");
+
+    Corpus esperado;
+    cargarCorpus(copia.string(), esperado);
+    for (const auto &p : patrones)
+    {
+        if (buscarEnIndiceSegmentado(indice, p).size() != kmpSearch<Offset>(esperado.texto(), p).size())
+            std::cout << "  Patron \"" << p << "\": DIFIERE de KMP sobre la carpeta\n";
+    }
+    fs::remove_all(copia, ec);
+}
+
+// Listado de documentos: ubicar cada ocurrencia con el SA y armar el histograma
+// contra el SA generalizado, que solo visita un representante por documento
+template <typename Offset>
+void runListadoDocumentos(const Corpus &corpus, const std::vector<std::string> &patrones)
+{
+    std::cout << "\n=== Listado de documentos (SA generalizado) ===\n";
+    std::string_view texto = corpus.texto();
+    std::vector<Offset> cortes(corpus.cortes.begin(), corpus.cortes.end());
+
+    auto t0_build = HRClock::now();
+    SAGeneralizadoT<Offset> g = construirSAGeneralizado<Offset>(texto, corpus.cortes);
+    auto t1_build = HRClock::now();
+    auto build_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_build - t0_build).count();
+    std::cout << "  Construccion: " << build_ms << " ms (" << g.numDocs << " documentos)\n";
+
+    for (const auto &p : patrones)
+    {
+        auto t0 = HRClock::now();
+        auto occs = buscarConSuffixArray(texto, p, g.sa, g.lcp);
+        auto histograma = histogramaDocumentos(occs, cortes.data(), cortes.size());
+        auto t1 = HRClock::now();
+        auto conteos = conteoPorDocumento(g, texto, p);
+        auto t2 = HRClock::now();
+
+        bool iguales = true;
+        size_t conPatron = 0;
+        for (int c : histograma)
+            conPatron += c > 0;
+        if (conPatron != conteos.size())
+            iguales = false;
+        for (const auto &c : conteos)
+            iguales = iguales && histograma[c.doc] == (int)c.cuenta;
+
+        auto ubicar_us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+        auto listar_us = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+        std::cout << "  Patron \"" << p << "\": " << occs.size() << " ocurrencias en " << conteos.size()
+                  << " documentos; ubicar + histograma " << ubicar_us << " us, listado " << listar_us << " us"
+                  << (iguales ? "" : " (DIFIERE)") << "\n";
+    }
+}
+
+// Busqueda aproximada con 0, 1 y 2 ediciones contra la exacta (SIMD), con los
+// documentos que contienen cada patron por la misma via que las coincidencias exactas
+template <typename Offset>
+void runBusquedaAproximada(const Corpus &corpus, const std::vector<std::string> &patrones)
+{
+    std::cout << "\n=== Busqueda aproximada (ediciones) ===\n";
+    std::string_view texto = corpus.texto();
+    std::vector<Offset> cortes(corpus.cortes.begin(), corpus.cortes.end());
+
+    for (const auto &p : patrones)
+    {
+        auto t0 = HRClock::now();
+        size_t exactas = simdSearch<Offset>(texto, p).size();
+        auto t1 = HRClock::now();
+        auto exacta_us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+        std::cout << "  Patron \"" << p << "\": exacta " << exactas << " en " << exacta_us << " us\n";
+
+        for (int k = 0; k <= 2; ++k)
+        {
+            t0 = HRClock::now();
+            auto finales = busquedaAproximada<Offset>(texto, p, k);
+            t1 = HRClock::now();
+            auto us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+            auto ocurrencias = agruparFinalesVecinos(finales);
+            int docs = 0;
+            for (int c : histogramaDocumentos(ocurrencias, cortes.data(), cortes.size()))
+                docs += c > 0;
+            std::cout << "    k = " << k << ": " << ocurrencias.size() << " ocurrencias (" << finales.size()
+                      << " posiciones finales) en " << docs << " documentos, " << us << " us"
+                      << (k == 0 && finales.size() != exactas ? " (DIFIERE de la exacta)" : "") << "\n";
+        }
+    }
+
+    // Regresion: ninguna coincidencia puede cruzar el '$' entre dos documentos
+    // (recorrido bit-paralelo con "cdef", filtro por palomar con "abcdefgh")
+    const std::string separados = "xxabcd$efghyy$";
+    const std::pair<const char *, TipoError> casos[] = {
+        {"cdef", TipoError::Edicion}, {"cdef", TipoError::Sustitucion},
+        {"abcdefgh", TipoError::Edicion}, {"abcdefgh", TipoError::Sustitucion}};
+    bool cruza = false;
+    for (const auto &[patron, tipo] : casos)
+        cruza |= !busquedaAproximada(separados, patron, 1, tipo).empty();
+    std::cout << "  Separador de documentos: " << (cruza ? "hay coincidencias que CRUZAN documentos" : "ok") << "\n";
+}
+
+// Construccion del suffix array con 1, 2, 4, ... hasta 'maxHilos' hilos:
+// tiempo y pico de memoria sobre la memoria previa (SA + temporales; lo que
+// el asignador reutiliza de bloques ya liberados no aparece en el pico)
+template <typename Offset>
+void runConstruccionParalela(std::string_view texto, int maxHilos)
+{
+    std::cout << "\n=== Construccion paralela del suffix array ===\n";
+    size_t mem_base = reiniciarMemoriaPicoKB();
+    auto t0_sais = HRClock::now();
+    std::vector<Offset> referencia = construirSuffixArray<Offset>(texto);
+    auto t1_sais = HRClock::now();
+    auto sais_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1_sais - t0_sais).count();
+    std::cout << "  SA-IS (1 hilo): " << sais_ms << " ms, pico " << getMemoryPicoKB() - mem_base << " KB\n";
+
+    for (int h = 1;; h = std::min(h * 2, maxHilos))
+    {
+        mem_base = reiniciarMemoriaPicoKB();
+        auto t0 = HRClock::now();
+        std::vector<Offset> sa = construirSuffixArray<Offset>(texto, MetodoSA::DuplicacionParalela, h);
+        auto t1 = HRClock::now();
+        size_t pico = getMemoryPicoKB() - mem_base;
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+        std::cout << "  Duplicacion paralela, " << h << " hilo(s): " << ms << " ms, pico " << pico << " KB"
+                  << (sa == referencia ? "" : " (DIFIERE de SA-IS!)") << "\n";
+        if (h == maxHilos)
+            break;
+    }
+}
+
+// Carga del corpus con 1, 2, 4, ... hasta 'maxHilos' hilos de lectura
+void runCargaParalela(const std::string &carpeta, int maxHilos)
+{
+    std::cout << "\n=== Carga paralela de documentos ===\n";
+    double base_us = 0;
+    for (int h = 1;; h = std::min(h * 2, maxHilos))
+    {
+        auto t0 = HRClock::now();
+        Corpus corpus;
+        cargarCorpus(carpeta, corpus, h);
+        auto t1 = HRClock::now();
+        double us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+        if (h == 1)
+            base_us = us;
+        std::cout << "  " << h << " hilo(s): " << us << " us (speedup " << (us > 0 ? base_us / us : 0) << "x)\n";
+        if (h == maxHilos)
+            break;
+    }
+}
+
+// Busqueda por flujo: la carpeta se lee de a un archivo en bloques fijos, sin
+// armar la concatenacion; se comprueba contra la busqueda en memoria
+template <typename Offset>
+void runBusquedaFlujo(const std::string &carpeta, std::string_view texto, const std::vector<std::string> &patrones)
+{
+    std::cout << "\n=== Busqueda por flujo (bloques) ===\n";
+    const std::pair<const char *, AlgoritmoFlujo> algoritmos[] = {
+        {"KMP", AlgoritmoFlujo::KMP}, {"Automata", AlgoritmoFlujo::Automata}, {"Rabin-Karp", AlgoritmoFlujo::RabinKarp}};
+
+    for (size_t tamBloque : {4096u, 65536u, 1048576u})
+    {
+        for (const auto &[nombre, algoritmo] : algoritmos)
+        {
+            size_t mem_inicial = getMemoryKB();
+            size_t total = 0;
+            bool iguales = true;
+            auto t0 = HRClock::now();
+            for (const auto &p : patrones)
+            {
+                // Solo contar: las coincidencias no se guardan en ningun vector
+                SumideroResultados64 contar = {ModoResultado::Contar, 0, 0, nullptr};
+                buscarEnCarpetaPorFlujo(carpeta, p, algoritmo, tamBloque, contar);
+                total += contar.cuenta;
+                iguales = iguales && contar.cuenta == kmpSearch<Offset>(texto, p).size();
+            }
+            auto t1 = HRClock::now();
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+            std::cout << "  " << nombre << ", bloque " << tamBloque / 1024 << " KB: " << total << " ocurrencias en "
+                      << ms << " ms, Memoria extra: " << (getMemoryKB() - mem_inicial) << " KB"
+                      << (iguales ? "" : " (DIFIERE de la busqueda en memoria)") << "\n";
+        }
+    }
+}
+
+// Busqueda por trozos en paralelo: speedup de cada algoritmo a 1/2/4/8/N hilos
+template <typename Offset>
+void runBusquedaParalela(std::string_view texto, const std::vector<std::string> &patrones, int maxHilos)
+{
+    std::cout << "\n=== Busqueda paralela por trozos ===\n";
+
+    std::vector<int> hilos = {1, 2, 4, 8, maxHilos};
+    std::sort(hilos.begin(), hilos.end());
+    hilos.erase(std::unique(hilos.begin(), hilos.end()), hilos.end());
+
+    // Cada trozo mide a lo sumo 1 GiB y usa el kernel de 32 bits; la referencia
+    // secuencial recorre el texto completo y necesita los offsets del corpus
+    std::vector<std::tuple<std::string, FuncionBusqueda, FuncionBusquedaT<Offset>>> kernels = {
+        {"KMP", kmpSearch, kmpSearch<Offset>},
+        {"Boyer-Moore", boyerMooreSearch, boyerMooreSearch<Offset>},
+        {"Horspool", horspoolSearch, horspoolSearch<Offset>},
+        {"Sunday", sundaySearch, sundaySearch<Offset>},
+        {"Rabin-Karp", rabinKarpSearch, rabinKarpSearch<Offset>},
+        {"Automata", automataSearch, automataSearch<Offset>},
+        {"SIMD", simdSearch, simdSearch<Offset>},
+        {"Shift-Or", shiftOrSearch, shiftOrSearch<Offset>}};
+
+    for (const auto &[nombre, kernel, secuencial] : kernels)
+    {
+        std::cout << "  " << nombre << ":\n";
+        double base_us = 0;
+        for (int h : hilos)
+        {
+            std::vector<std::vector<Offset>> resultados;
+            auto t0 = HRClock::now();
+            for (const auto &p : patrones)
+            {
+                resultados.push_back(busquedaParalela<Offset>(texto, p, kernel, h));
+            }
+            auto t1 = HRClock::now();
+
+            // Debe coincidir exactamente con la version secuencial
+            bool iguales = true;
+            for (size_t i = 0; i < patrones.size(); ++i)
+            {
+                iguales = iguales && resultados[i] == secuencial(texto, patrones[i]);
+            }
+            double us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+            if (h == 1)
+                base_us = us;
+            std::cout << "    " << h << " hilo(s): " << us << " us (speedup " << (us > 0 ? base_us / us : 0) << "x)"
+                      << (iguales ? "" : " RESULTADOS DISTINTOS!") << "\n";
+        }
+    }
+}
+
+// Todas las pruebas con los offsets que necesita el corpus cargado
+template <typename Offset>
+void runAll(const Corpus &corpus, const std::vector<std::string> &patrones, int hilos)
+{
+    std::string_view texto = corpus.texto();
+
+    // Ejecutar cada algoritmo
+    runKMP<Offset>(texto, patrones);
+    runBoyerMoore<Offset>(texto, patrones);
+    runAlgoritmo<Offset>("Boyer-Moore-Horspool", horspoolSearch<Offset>, texto, patrones);
+    runAlgoritmo<Offset>("Sunday (quick search)", sundaySearch<Offset>, texto, patrones);
+    runRabinKarp<Offset>(texto, patrones);
+    runAutomata<Offset>(texto, patrones);
+    runSIMD<Offset>(texto, patrones);
+    runAlgoritmo<Offset>("Shift-Or (bit-paralelo)", shiftOrSearch<Offset>, texto, patrones);
+    runAhoCorasick<Offset>(texto, patrones);
+    runRabinKarpMulti<Offset>(texto, patrones);
+    runShiftOrMulti<Offset>(texto, patrones);
+
+    // Ejecutar la estructura
+    runSuffixArray<Offset>(texto, patrones);
+    runFMIndex<Offset>(texto, patrones);
+    runIndiceMapeado("datos/documentos/", "datos/indice.idx", patrones);
+    runIndiceSegmentado<Offset>(corpus, patrones);
+    runSincronizacionCarpeta<Offset>("datos/documentos/", patrones);
+    runListadoDocumentos<Offset>(corpus, patrones);
+    runBusquedaAproximada<Offset>(corpus, patrones);
+
+    // Escalamiento de la carga y de la busqueda segun la cantidad de hilos
+    runCargaParalela("datos/documentos/", hilos);
+    runConstruccionParalela<Offset>(texto, hilos);
+    runBusquedaParalela<Offset>(texto, patrones, hilos);
+    runBusquedaFlujo<Offset>("datos/documentos/", texto, patrones);
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-int main()
+// Uso: benchmark [--hilos N]   (hilos para carga y busqueda paralela; por defecto todos)
+int main(int argc, char *argv[])
 {
-    // Preparar datos de prueba
-    std::vector<std::string> nombres;
-    std::vector<int> cortes;
-    std::string texto = leerDocumentosDesdeCarpeta("datos/documentos/", nombres, cortes);
+    int hilos = hilosDisponibles();
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--hilos")
+            hilos = std::max(1, std::atoi(argv[++i]));
+    }
 
-    std::cout << "Texto cargado: " << texto.size() << " caracteres, " << nombres.size() << " documentos\n";
+    // Preparar datos de prueba (un solo buffer, sin copias intermedias)
+    auto t0_carga = HRClock::now();
+    Corpus corpus;
+    cargarCorpus("datos/documentos/", corpus, hilos);
+    std::string_view texto = corpus.texto();
+    auto t1_carga = HRClock::now();
+    auto carga_us = std::chrono::duration_cast<std::chrono::microseconds>(t1_carga - t0_carga).count();
+
+    std::cout << "Texto cargado: " << texto.size() << " caracteres, " << corpus.nombres.size()
+              << " documentos en " << carga_us << " us (" << hilos << " hilos)\n";
 
     // Definir patrones a leer de los archivos (Se dejan preestablecidos los patrones aqui)
     std::vector<std::string> patrones = {
         "bin", "datos", "busqueda", "criptograficas"};
 
-    // Ejecutar cada algoritmo
-    runKMP(texto, patrones);
-    runBoyerMoore(texto, patrones);
-    runRabinKarp(texto, patrones);
-    runAutomata(texto, patrones);
-
-    // Ejecutar la estructura
-    runSuffixArray(texto, patrones);
+    // Offsets de 64 bits solo si el corpus no cabe en 32 (ver necesitaOffset64)
+    if (necesitaOffset64(corpus.tam))
+        runAll<Offset64>(corpus, patrones, hilos);
+    else
+        runAll<Offset32>(corpus, patrones, hilos);
 
     return 0;
 }
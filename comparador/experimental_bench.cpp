@@ -9,6 +9,7 @@
 #include <numeric>
 #include <iomanip>
 #include <thread>
+#include <cstdlib>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -19,11 +20,18 @@
 
 // Incluimos todos los headers de los algoritmos y estructuras
 #include "io.h"
+#include "paralelo.h"
 #include "kmp.h"
 #include "boyer_moore.h"
 #include "rabin_karp.h"
+#include "shift_or.h"
 #include "automata.h"
+#include "simd.h"
+#include "aho_corasick.h"
+#include "busqueda_paralela.h"
 #include "suffix_array.h"
+#include "fm_index.h"
+#include "patron_compilado.h"
 
 using HRClock = std::chrono::high_resolution_clock;
 
@@ -36,6 +44,7 @@ struct ExperimentResult
     int tamaño_texto;
     double tiempo_promedio_ms;
     double desviacion_std_ms;
+    double preproceso_ms; // preparacion unica (tablas, automata, suffix array)
     size_t memoria_promedio_kb;
     int total_ocurrencias;
     int repeticiones;
@@ -144,53 +153,157 @@ std::vector<std::string> generarPatrones(const std::string &texto, int num_patro
     return patrones;
 }
 
-// Funcion para medir tiempo de ejecucion de un algoritmo (VERSION RAPIDA)
-std::tuple<double, size_t, int> medirAlgoritmo(const std::string &algoritmo,
+// Algoritmo de un solo patron asociado al nombre (false si no es de ese tipo)
+bool algoritmoPatronPorNombre(const std::string &algoritmo, AlgoritmoPatron &salida)
+{
+    static const std::pair<const char *, AlgoritmoPatron> tabla[] = {
+        {"KMP", AlgoritmoPatron::KMP},
+        {"Boyer-Moore", AlgoritmoPatron::BoyerMoore},
+        {"Rabin-Karp", AlgoritmoPatron::RabinKarp},
+        {"Horspool", AlgoritmoPatron::Horspool},
+        {"Sunday", AlgoritmoPatron::Sunday},
+        {"Automata", AlgoritmoPatron::Automata},
+        {"SIMD", AlgoritmoPatron::SIMD},
+        {"Shift-Or", AlgoritmoPatron::ShiftOr}};
+    for (const auto &[nombre, a] : tabla)
+    {
+        if (algoritmo == nombre)
+        {
+            salida = a;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Lo que cada algoritmo arma una sola vez por experimento: patrones
+// compilados, automata o tablas multipatron, suffix array. Las repeticiones
+// solo miden el recorrido del texto; la preparacion se reporta aparte.
+template <typename Offset>
+struct PreparacionAlgoritmo
+{
+    bool unPatron = false;
+    CachePatrones cache;
+    std::vector<const PatronCompilado *> compilados;
+    AhoCorasick ac;
+    RabinKarpMulti rk;
+    ShiftOrMulti so;
+    std::vector<Offset> suffixArray;
+    LCPBusquedaT<Offset> lcp;
+    FMIndexT<Offset> fm;
+};
+
+// Arma la preparacion del algoritmo y devuelve su tiempo en ms
+template <typename Offset>
+double prepararAlgoritmo(const std::string &algoritmo,
+                         const std::string &texto,
+                         const std::vector<std::string> &patrones,
+                         PreparacionAlgoritmo<Offset> &prep)
+{
+    auto inicio = HRClock::now();
+
+    AlgoritmoPatron a;
+    if (algoritmoPatronPorNombre(algoritmo, a))
+    {
+        prep.unPatron = true;
+        prep.compilados = compilarConjunto(prep.cache, patrones, a);
+    }
+    else if (algoritmo == "Aho-Corasick")
+    {
+        prep.ac = construirAhoCorasick(patrones);
+    }
+    else if (algoritmo == "Rabin-Karp-Multi")
+    {
+        prep.rk = construirRabinKarpMulti(patrones);
+    }
+    else if (algoritmo == "Shift-Or-Multi")
+    {
+        prep.so = construirShiftOrMulti(patrones);
+    }
+    else if (algoritmo == "Suffix-Array")
+    {
+        prep.suffixArray = construirSuffixArray<Offset>(texto);
+        prep.lcp = construirLCPBusqueda(construirLCP(texto, prep.suffixArray));
+    }
+    else if (algoritmo == "FM-Index")
+    {
+        prep.fm = construirFMIndex<Offset>(texto);
+    }
+
+    auto fin = HRClock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(fin - inicio).count() / 1000000.0;
+}
+
+// Funcion para medir tiempo de ejecucion de un algoritmo (VERSION RAPIDA).
+// Devuelve tiempo, memoria extra y ocurrencias totales: se cuenta en la misma
+// pasada que se mide, sin volver a buscar. Solo mide el recorrido del texto,
+// con la preparacion ya hecha. Offset es el ancho de las posiciones
+// (Offset64 solo si el texto no cabe en 32 bits).
+template <typename Offset>
+std::tuple<double, size_t, size_t> medirAlgoritmo(const std::string &algoritmo,
                                                const std::string &texto,
-                                               const std::vector<std::string> &patrones)
+                                               const std::vector<std::string> &patrones,
+                                               const PreparacionAlgoritmo<Offset> &prep,
+                                               int hilos = 1)
 {
     // Medicion inicial de memoria
     size_t mem_inicial = getMemoryKB();
 
+    size_t ocurrencias = 0;
     auto inicio = HRClock::now();
 
-    // Ejecutar el algoritmo correspondiente (SIN AUTOMATA para evitar segfault)
-    if (algoritmo == "KMP")
+    // Ejecutar el algoritmo correspondiente
+    if (prep.unPatron && hilos > 1)
     {
-        for (const auto &p : patrones)
+        // Modo lote: un patron por tarea en un pool con robo de trabajo
+        for (const auto &occ : busquedaLote<Offset>(texto, prep.compilados, hilos))
         {
-            kmpSearch(texto, p);
+            ocurrencias += occ.size();
         }
     }
-    else if (algoritmo == "Boyer-Moore")
+    else if (prep.unPatron)
     {
-        for (const auto &p : patrones)
+        // Algoritmos de un solo patron: una pasada por patron, solo contando
+        SumideroResultados sumidero = sumideroContar();
+        for (const PatronCompilado *c : prep.compilados)
         {
-            boyerMooreSearch(texto, p);
+            buscarPatronCompilado(*c, texto, sumidero);
         }
+        ocurrencias = sumidero.cuenta;
     }
-    else if (algoritmo == "Rabin-Karp")
+    else if (algoritmo == "Aho-Corasick")
     {
-        for (const auto &p : patrones)
-        {
-            rabinKarpSearch(texto, p);
-        }
+        // Una sola pasada sobre el texto para todos los patrones
+        ocurrencias = ahoCorasickSearch<Offset>(prep.ac, texto).size();
+    }
+    else if (algoritmo == "Rabin-Karp-Multi")
+    {
+        // Una pasada por cada longitud distinta de patron
+        ocurrencias = rabinKarpMultiSearch<Offset>(prep.rk, texto).size();
     }
-    else if (algoritmo == "Automata")
+    else if (algoritmo == "Shift-Or-Multi")
     {
-        // AUTOMATA CORREGIDO - Probando la corrección
+        // Una sola pasada; los patrones cortos empaquetados en palabras de 64 bits
+        ocurrencias = shiftOrMultiSearch<Offset>(prep.so, texto).size();
+    }
+    else if (algoritmo == "Suffix-Array")
+    {
+        SumideroResultadosT<Offset> sumidero; // modo Contar
         for (const auto &p : patrones)
         {
-            automataSearch(texto, p);
+            buscarConSuffixArray(texto, p, prep.suffixArray, prep.lcp, sumidero);
         }
+        ocurrencias = sumidero.cuenta;
     }
-    else if (algoritmo == "Suffix-Array")
+    else if (algoritmo == "FM-Index")
     {
-        auto suffixArray = construirSuffixArray(texto);
+        // Busqueda hacia atras: cuenta sin ubicar ni mirar el texto
+        SumideroResultadosT<Offset> sumidero; // modo Contar
         for (const auto &p : patrones)
         {
-            buscarConSuffixArray(texto, p, suffixArray);
+            buscarConFMIndex(prep.fm, p, sumidero);
         }
+        ocurrencias = sumidero.cuenta;
     }
 
     auto fin = HRClock::now();
@@ -215,9 +328,16 @@ std::tuple<double, size_t, int> medirAlgoritmo(const std::string &algoritmo,
         {
             memoria_extra = texto.size() / 1024 + 1; // Suffix array usa ~texto en memoria
         }
+        else if (algoritmo == "FM-Index")
+        {
+            memoria_extra = bytesFMIndex(prep.fm) / 1024 + 1; // BWT comprimida + SA muestreado
+        }
         else if (algoritmo == "Automata")
         {
-            memoria_extra = patrones.size() * 10 / 1024 + 1; // Automata: DFA por patron
+            size_t max_len = 0;
+            for (const auto &p : patrones)
+                max_len = std::max(max_len, p.size());
+            memoria_extra = (max_len + 1) * 256 * sizeof(int) / 1024 + 1; // Automata: tabla (m+1) x 256
         }
         else
         {
@@ -225,27 +345,38 @@ std::tuple<double, size_t, int> medirAlgoritmo(const std::string &algoritmo,
         }
     }
 
-    return {tiempo_ms, memoria_extra, 1};
+    return {tiempo_ms, memoria_extra, ocurrencias};
 }
 
-// Funcion para realizar experimento con repeticiones (VERSION RAPIDA)
-ExperimentResult realizarExperimento(const std::string &algoritmo,
-                                     const std::string &texto,
-                                     const std::vector<std::string> &patrones,
-                                     int num_documentos,
-                                     int repeticiones = 20)
+// Funcion para realizar experimento con repeticiones (VERSION RAPIDA): la
+// preparacion se hace una vez y las repeticiones solo recorren el texto
+template <typename Offset>
+ExperimentResult realizarExperimentoT(const std::string &algoritmo,
+                                      const std::string &texto,
+                                      const std::vector<std::string> &patrones,
+                                      int num_documentos,
+                                      int repeticiones,
+                                      int hilos)
 {
     std::vector<double> tiempos;
     std::vector<size_t> memorias;
+    size_t total_ocurrencias = 0; // contadas en la misma pasada que se mide
 
     std::cout << "  Ejecutando " << algoritmo << " con " << patrones.size()
               << " patrones..." << std::flush;
 
+    size_t mem_antes = getMemoryKB();
+    PreparacionAlgoritmo<Offset> prep;
+    double preproceso_ms = prepararAlgoritmo(algoritmo, texto, patrones, prep);
+    size_t mem_despues = getMemoryKB();
+    size_t mem_preparacion = mem_despues > mem_antes ? mem_despues - mem_antes : 0;
+
     for (int i = 0; i < repeticiones; ++i)
     {
-        auto [tiempo, memoria, reps_internas] = medirAlgoritmo(algoritmo, texto, patrones);
+        auto [tiempo, memoria, ocurrencias] = medirAlgoritmo<Offset>(algoritmo, texto, patrones, prep, hilos);
         tiempos.push_back(tiempo);
-        memorias.push_back(memoria);
+        memorias.push_back(memoria + mem_preparacion);
+        total_ocurrencias = ocurrencias;
 
         if ((i + 1) % 5 == 0)
         {
@@ -263,45 +394,6 @@ ExperimentResult realizarExperimento(const std::string &algoritmo,
     double desviacion_std = std::sqrt(suma_cuadrados / tiempos.size());
     size_t memoria_promedio = std::accumulate(memorias.begin(), memorias.end(), 0ULL) / memorias.size();
 
-    // Contar ocurrencias totales
-    int total_ocurrencias = 0;
-    if (algoritmo == "KMP")
-    {
-        for (const auto &p : patrones)
-        {
-            total_ocurrencias += kmpSearch(texto, p).size();
-        }
-    }
-    else if (algoritmo == "Boyer-Moore")
-    {
-        for (const auto &p : patrones)
-        {
-            total_ocurrencias += boyerMooreSearch(texto, p).size();
-        }
-    }
-    else if (algoritmo == "Rabin-Karp")
-    {
-        for (const auto &p : patrones)
-        {
-            total_ocurrencias += rabinKarpSearch(texto, p).size();
-        }
-    }
-    else if (algoritmo == "Automata")
-    {
-        for (const auto &p : patrones)
-        {
-            total_ocurrencias += automataSearch(texto, p).size();
-        }
-    }
-    else if (algoritmo == "Suffix-Array")
-    {
-        auto suffixArray = construirSuffixArray(texto);
-        for (const auto &p : patrones)
-        {
-            total_ocurrencias += buscarConSuffixArray(texto, p, suffixArray).size();
-        }
-    }
-
     std::cout << " Completado!\n";
 
     return {
@@ -311,11 +403,24 @@ ExperimentResult realizarExperimento(const std::string &algoritmo,
         static_cast<int>(texto.size()),
         tiempo_promedio,
         desviacion_std,
+        preproceso_ms,
         memoria_promedio,
-        total_ocurrencias,
+        static_cast<int>(total_ocurrencias),
         repeticiones};
 }
 
+ExperimentResult realizarExperimento(const std::string &algoritmo,
+                                     const std::string &texto,
+                                     const std::vector<std::string> &patrones,
+                                     int num_documentos,
+                                     int repeticiones = 20,
+                                     int hilos = 1)
+{
+    if (necesitaOffset64(texto.size()))
+        return realizarExperimentoT<Offset64>(algoritmo, texto, patrones, num_documentos, repeticiones, hilos);
+    return realizarExperimentoT<Offset32>(algoritmo, texto, patrones, num_documentos, repeticiones, hilos);
+}
+
 // Funcion para exportar resultados a CSV
 void exportarResultados(const std::vector<ExperimentResult> &resultados, const std::string &archivo)
 {
@@ -328,7 +433,7 @@ void exportarResultados(const std::vector<ExperimentResult> &resultados, const s
 
     // Cabecera CSV
     file << "Algoritmo,Num_Documentos,Patrones_Cargados,Tamaño_Texto_Chars,Tiempo_Promedio_ms,"
-         << "Desviacion_Std_ms,Memoria_Promedio_KB,Total_Ocurrencias,Repeticiones\n";
+         << "Desviacion_Std_ms,Preproceso_ms,Memoria_Promedio_KB,Total_Ocurrencias,Repeticiones\n";
 
     // Datos
     for (const auto &resultado : resultados)
@@ -340,6 +445,7 @@ void exportarResultados(const std::vector<ExperimentResult> &resultados, const s
              << resultado.tamaño_texto << ","
              << resultado.tiempo_promedio_ms << ","
              << resultado.desviacion_std_ms << ","
+             << resultado.preproceso_ms << ","
              << resultado.memoria_promedio_kb << ","
              << resultado.total_ocurrencias << ","
              << resultado.repeticiones << "\n";
@@ -372,7 +478,7 @@ void guardarResultadoParcial(const ExperimentResult &resultado, const std::strin
     if (!archivo_existe)
     {
         file << "Algoritmo,Num_Documentos,Patrones_Cargados,Tamaño_Texto_Chars,Tiempo_Promedio_ms,"
-             << "Desviacion_Std_ms,Memoria_Promedio_KB,Total_Ocurrencias,Repeticiones\n";
+             << "Desviacion_Std_ms,Preproceso_ms,Memoria_Promedio_KB,Total_Ocurrencias,Repeticiones\n";
     }
 
     // Escribir el resultado
@@ -383,6 +489,7 @@ void guardarResultadoParcial(const ExperimentResult &resultado, const std::strin
          << resultado.tamaño_texto << ","
          << resultado.tiempo_promedio_ms << ","
          << resultado.desviacion_std_ms << ","
+         << resultado.preproceso_ms << ","
          << resultado.memoria_promedio_kb << ","
          << resultado.total_ocurrencias << ","
          << resultado.repeticiones << "\n";
@@ -395,43 +502,63 @@ void guardarResultadoParcial(const ExperimentResult &resultado, const std::strin
 void mostrarResumen(const std::vector<ExperimentResult> &resultados)
 {
     std::cout << "\n=== RESUMEN DE RESULTADOS EXPERIMENTALES ===\n";
-    std::cout << std::left << std::setw(15) << "Algoritmo"
+    std::cout << std::left << std::setw(18) << "Algoritmo"
               << std::setw(8) << "Docs"
               << std::setw(10) << "Patrones"
               << std::setw(12) << "Tamano(KB)"
               << std::setw(12) << "Tiempo(ms)"
               << std::setw(10) << "Std(ms)"
+              << std::setw(12) << "Prep(ms)"
               << std::setw(10) << "Mem(KB)"
               << std::setw(12) << "Ocurrencias" << std::endl;
-    std::cout << std::string(95, '-') << std::endl;
+    std::cout << std::string(110, '-') << std::endl;
 
     for (const auto &r : resultados)
     {
-        std::cout << std::left << std::setw(15) << r.algoritmo
+        std::cout << std::left << std::setw(18) << r.algoritmo
                   << std::setw(8) << r.num_documentos
                   << std::setw(10) << r.num_patrones
                   << std::setw(12) << (r.tamaño_texto / 1024)
                   << std::setw(12) << std::fixed << std::setprecision(2) << r.tiempo_promedio_ms
                   << std::setw(10) << std::fixed << std::setprecision(2) << r.desviacion_std_ms
+                  << std::setw(12) << std::fixed << std::setprecision(2) << r.preproceso_ms
                   << std::setw(10) << r.memoria_promedio_kb
                   << std::setw(12) << r.total_ocurrencias << std::endl;
     }
 }
 
-int main()
+// Uso: experimental [--hilos N]
+// Con N > 1 los algoritmos de un solo patron (KMP, Boyer-Moore, Horspool,
+// Sunday, Rabin-Karp, Automata, SIMD, Shift-Or) procesan cada archivo de patrones
+// como un lote repartido en N hilos (pool con robo de trabajo).
+int main(int argc, char *argv[])
 {
     std::cout << "=== ESTUDIO EXPERIMENTAL AUTOMATIZADO ===\n\n";
 
+    int hilos = 1;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--hilos")
+            hilos = std::max(1, std::atoi(argv[++i]));
+    }
+    if (hilos > 1)
+    {
+        std::cout << "Modo lote: " << hilos << " hilos (de " << hilosDisponibles() << " disponibles)\n\n";
+    }
+
     // Cargar todos los documentos disponibles
-    std::vector<std::string> nombres;
-    std::vector<int> cortes;
-    std::string texto_completo = leerDocumentosDesdeCarpeta("datos/documentos/", nombres, cortes);
+    Corpus corpus;
+    cargarCorpus("datos/documentos/", corpus);
+    std::string_view texto_completo = corpus.texto();
+    const std::vector<std::string> &nombres = corpus.nombres;
+    const std::vector<int64_t> &cortes = corpus.cortes;
 
     std::cout << "Documentos disponibles: " << nombres.size() << std::endl;
-    std::cout << "Texto total: " << texto_completo.size() << " caracteres\n\n";
+    std::cout << "Texto total: " << texto_completo.size() << " caracteres\n";
+    std::cout << "SIMD: " << simdInstrucciones() << "\n\n";
 
     // Configuracion del experimento (ACTUALIZADA para usar todos los documentos)
-    std::vector<std::string> algoritmos = {"KMP", "Boyer-Moore", "Rabin-Karp", "Automata", "Suffix-Array"};
+    std::vector<std::string> algoritmos = {"KMP", "Boyer-Moore", "Horspool", "Sunday", "Rabin-Karp", "Automata", "SIMD", "Shift-Or", "Aho-Corasick", "Rabin-Karp-Multi", "Shift-Or-Multi", "Suffix-Array", "FM-Index"};
     std::vector<int> num_documentos_tests = {5, 10, 15, 20, 25, 30, 35, 40, 45, 50};
     std::vector<std::string> archivos_patrones = {"patrones_50.txt", "patrones_100.txt", "patrones_150.txt", "patrones_200.txt", "patrones_250.txt"};
     int repeticiones = 20;
@@ -469,8 +596,8 @@ int main()
         {
             if (i < static_cast<int>(cortes.size()) - 1)
             {
-                int inicio = (i == 0) ? 0 : cortes[i];
-                int fin = cortes[i + 1];
+                int64_t inicio = (i == 0) ? 0 : cortes[i];
+                int64_t fin = cortes[i + 1];
                 texto_experimento += texto_completo.substr(inicio, fin - inicio);
             }
         }
@@ -492,7 +619,7 @@ int main()
             for (const auto &algoritmo : algoritmos)
             {
                 auto resultado = realizarExperimento(algoritmo, texto_experimento,
-                                                     patrones, num_docs, repeticiones);
+                                                     patrones, num_docs, repeticiones, hilos);
                 todos_resultados.push_back(resultado);
             }
         }
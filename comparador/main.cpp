@@ -3,21 +3,31 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <algorithm>
+#include <cstdlib>
 #include "io.h"
 
 #include "kmp.h"
 #include "boyer_moore.h"
 #include "rabin_karp.h"
 #include "automata.h"
+#include "simd.h"
+#include "aho_corasick.h"
+#include "busqueda_aproximada.h"
 #include "suffix_array.h"
+#include "indice_persistente.h"
 
 using HighResClock = std::chrono::high_resolution_clock;
 
 // Ejecuta algoritmo sobre un texto concatenado de varios documentos y mide tiempos
-void buscarPatrones(const std::string &texto,
-                    const std::vector<std::string> &nombresDoc,
-                    const std::vector<int> &cortes)
+// (Offset es el ancho de los arreglos del indice: Offset32 u Offset64). Con
+// errores > 0 tambien busca cada patron con hasta 'errores' ediciones.
+template <typename Offset>
+void buscarPatrones(const IndiceMapeado &indice, int errores)
 {
+    std::string_view texto = indice.texto;
+    const ArreglosIndice<Offset> &arreglos = indice.arreglos<Offset>();
+
     std::cout << "Ingresa patrones (una linea c/u), luego Ctrl+D para buscar:\n";
     std::vector<std::string> patrones;
     std::string pat;
@@ -32,57 +42,120 @@ void buscarPatrones(const std::string &texto,
         return;
     }
 
-    // Construir suffix array una vez
-    std::vector<int> suffixArray = construirSuffixArray(texto);
+    // Aho-Corasick: todos los patrones en una sola pasada sobre el texto
+    auto t0_ac = HighResClock::now();
+    AhoCorasick ac = construirAhoCorasick(patrones);
+    auto occs_ac = ahoCorasickSearch<Offset>(ac, texto);
+    auto t1_ac = HighResClock::now();
+    auto ms_ac = std::chrono::duration_cast<std::chrono::milliseconds>(t1_ac - t0_ac).count();
+    std::vector<int> conteo_ac(patrones.size(), 0);
+    for (const auto &[id, pos] : occs_ac)
+    {
+        conteo_ac[id]++;
+    }
+    std::cout << "Aho-Corasick (todos los patrones): " << occs_ac.size() << " ocurrencias en " << ms_ac << " ms\n";
 
     auto t0_total = HighResClock::now();
-    for (const auto &p : patrones)
+    for (size_t ip = 0; ip < patrones.size(); ++ip)
     {
+        const auto &p = patrones[ip];
         std::cout << "\n=== Patron: \"" << p << "\" ===\n";
 
         // KMP
         auto t0 = HighResClock::now();
-        auto occs_kmp = kmpSearch(texto, p);
+        auto occs_kmp = kmpSearch<Offset>(texto, p);
         auto t1 = HighResClock::now();
         auto ms_kmp = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
         std::cout << "KMP: " << occs_kmp.size() << " ocurrencias en " << ms_kmp << " ms\n";
 
         // Boyer-Moore
         t0 = HighResClock::now();
-        auto occs_bm = boyerMooreSearch(texto, p);
+        auto occs_bm = boyerMooreSearch<Offset>(texto, p);
         t1 = HighResClock::now();
         auto ms_bm = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
         std::cout << "Boyer-Moore: " << occs_bm.size() << " ocurrencias en " << ms_bm << " ms\n";
 
+        // Horspool
+        t0 = HighResClock::now();
+        auto occs_hp = horspoolSearch<Offset>(texto, p);
+        t1 = HighResClock::now();
+        auto ms_hp = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+        std::cout << "Horspool: " << occs_hp.size() << " ocurrencias en " << ms_hp << " ms\n";
+
+        // Sunday
+        t0 = HighResClock::now();
+        auto occs_su = sundaySearch<Offset>(texto, p);
+        t1 = HighResClock::now();
+        auto ms_su = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+        std::cout << "Sunday: " << occs_su.size() << " ocurrencias en " << ms_su << " ms\n";
+
         // Rabin-Karp
         t0 = HighResClock::now();
-        auto occs_rk = rabinKarpSearch(texto, p);
+        auto occs_rk = rabinKarpSearch<Offset>(texto, p);
         t1 = HighResClock::now();
         auto ms_rk = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
         std::cout << "Rabin-Karp: " << occs_rk.size() << " ocurrencias en " << ms_rk << " ms\n";
 
         // Autómata
         t0 = HighResClock::now();
-        auto occs_auto = automataSearch(texto, p);
+        auto occs_auto = automataSearch<Offset>(texto, p);
         t1 = HighResClock::now();
         auto ms_auto = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
         std::cout << "Autómata: " << occs_auto.size() << " ocurrencias en " << ms_auto << " ms\n";
 
+        // SIMD
+        t0 = HighResClock::now();
+        auto occs_simd = simdSearch<Offset>(texto, p);
+        t1 = HighResClock::now();
+        auto ms_simd = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+        std::cout << "SIMD (" << simdInstrucciones() << "): " << occs_simd.size() << " ocurrencias en " << ms_simd << " ms\n";
+
         // Suffix Array
         t0 = HighResClock::now();
-        auto occs_sa = buscarConSuffixArray(texto, p, suffixArray);
+        auto occs_sa = buscarConSuffixArray(texto, p, arreglos.sa, arreglos.lcpIzq, arreglos.lcpDer);
         t1 = HighResClock::now();
         auto ms_sa = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
         std::cout << "Suffix Array: " << occs_sa.size() << " ocurrencias en " << ms_sa << " ms\n";
 
-        // Mostrar posiciones usando KMP como referencia
-        for (int pos : occs_kmp)
+        // Aho-Corasick (conteo de la pasada unica)
+        std::cout << "Aho-Corasick: " << conteo_ac[ip] << " ocurrencias (pasada unica)\n";
+
+        // Documentos que contienen el patron (KMP devuelve posiciones ordenadas)
+        std::vector<int> porDocumento = histogramaDocumentos(occs_kmp, arreglos.cortes, indice.numDocs);
+        int docsConPatron = 0;
+        for (int c : porDocumento)
+            docsConPatron += c > 0;
+        std::cout << "Presente en " << docsConPatron << " de " << indice.numDocs << " documentos\n";
+
+        // Mostrar posiciones usando KMP como referencia, ubicadas en una sola pasada
+        for (const UbicacionDoc &u : ubicarEnDocumentos(occs_kmp, arreglos.cortes, indice.numDocs))
+        {
+            std::cout << "  • Doc " << u.doc
+                      << " (“" << indice.nombre(u.doc - 1) << "”) @ pos "
+                      << u.offset << "\n";
+        }
+
+        // Busqueda aproximada: posiciones finales ubicadas por documento como las
+        // exactas; cada racha de finales vecinos cuenta como una ocurrencia
+        if (errores > 0)
         {
-            int docId = obtenerDocumento(pos, cortes);
-            int offset = (docId == 1 ? pos : pos - cortes[docId - 2]);
-            std::cout << "  • Doc " << docId
-                      << " (“" << nombresDoc[docId - 1] << "”) @ pos "
-                      << offset << "\n";
+            t0 = HighResClock::now();
+            auto finales_ap = busquedaAproximada<Offset>(texto, p, errores);
+            t1 = HighResClock::now();
+            auto ms_ap = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+            auto occs_ap = agruparFinalesVecinos(finales_ap);
+            std::vector<int> porDocAprox = histogramaDocumentos(occs_ap, arreglos.cortes, indice.numDocs);
+            int docsAprox = 0;
+            for (int c : porDocAprox)
+                docsAprox += c > 0;
+            std::cout << "Aproximada (<= " << errores << " ediciones): " << occs_ap.size() << " ocurrencias ("
+                      << finales_ap.size() << " posiciones finales) en " << docsAprox << " documentos, " << ms_ap
+                      << " ms\n";
+            for (size_t d = 0; d < porDocAprox.size(); ++d)
+            {
+                if (porDocAprox[d] > 0)
+                    std::cout << "  • Doc " << d + 1 << " (“" << indice.nombre(d) << "”): " << porDocAprox[d] << " ocurrencias\n";
+            }
         }
     }
     auto t1_total = HighResClock::now();
@@ -90,16 +163,42 @@ void buscarPatrones(const std::string &texto,
     std::cout << "\nTiempo total (todos patrones): " << total_ms << " ms\n";
 }
 
+// Uso: comparador [--errores K]
 int main(int argc, char *argv[])
 {
-    // Leer lista de archivos y concatenarlos
-    std::vector<std::string> nombresDoc;
-    std::vector<int> cortes;
+    int errores = 0;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--errores")
+            errores = std::max(0, std::atoi(argv[++i]));
+    }
 
-    // Se lee y concatenan los .txt
-    std::string texto = leerDocumentosDesdeCarpeta("datos/documentos/", nombresDoc, cortes);
+    const std::string carpeta = "datos/documentos/";
+    const std::string rutaIndice = "datos/indice.idx";
 
-    // Lanzar búsquedas
-    buscarPatrones(texto, nombresDoc, cortes);
+    // Mapear el indice persistente; si falta o el corpus cambio, se regenera
+    auto t0 = HighResClock::now();
+    IndiceMapeado indice;
+    bool vigente = cargarIndice(rutaIndice, indice) && indice.checksum == checksumCorpus(carpeta);
+    if (!vigente)
+    {
+        std::cout << "Indice ausente o desactualizado, generando " << rutaIndice << "...\n";
+        liberarIndice(indice); // soltar el mapeo viejo antes de reemplazar el archivo
+        if (!generarIndice(carpeta, rutaIndice) || !cargarIndice(rutaIndice, indice))
+        {
+            std::cerr << "Error: No se pudo preparar el indice.\n";
+            return 1;
+        }
+    }
+    auto t1 = HighResClock::now();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    std::cout << "Indice listo: " << indice.texto.size() << " caracteres, "
+              << indice.numDocs << " documentos (" << ms << " ms)\n";
+
+    // Lanzar búsquedas con el ancho de offset del indice
+    if (indice.offset64)
+        buscarPatrones<Offset64>(indice, errores);
+    else
+        buscarPatrones<Offset32>(indice, errores);
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include "io.h"
+#include "paralelo.h"
+#include "similitud.h"
+
+using HRClock = std::chrono::high_resolution_clock;
+
+// Pares de documentos parecidos por huellas de winnowing (sin comparar todos
+// contra todos). Uso:
+//   similitud [carpeta_documentos] [--k K] [--ventana W] [--hilos N] [--top T] [--umbral J] [--max-docs D]
+// --max-docs: las huellas compartidas por mas de D documentos se ignoran
+// (0 = ninguna); subirlo encuentra textos copiados en muchos documentos
+int main(int argc, char *argv[])
+{
+    std::string carpeta = "datos/documentos/";
+    ParametrosWinnowing parametros;
+    int hilos = hilosDisponibles();
+    size_t top = 20;
+    double umbral = 0.0;
+    size_t maxDocs = 64;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--k" && i + 1 < argc)
+            parametros.k = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--ventana" && i + 1 < argc)
+            parametros.ventana = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--hilos" && i + 1 < argc)
+            hilos = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--top" && i + 1 < argc)
+            top = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--umbral" && i + 1 < argc)
+            umbral = std::atof(argv[++i]);
+        else if (arg == "--max-docs" && i + 1 < argc)
+            maxDocs = std::max(0, std::atoi(argv[++i]));
+        else
+            carpeta = arg;
+    }
+
+    auto t0 = HRClock::now();
+    std::vector<std::string> nombres;
+    std::vector<int64_t> cortes;
+    std::string texto = leerDocumentosDesdeCarpeta(carpeta, nombres, cortes, hilos);
+    auto t1 = HRClock::now();
+    if (nombres.empty())
+    {
+        std::cerr << "Error: No hay documentos en " << carpeta << std::endl;
+        return 1;
+    }
+
+    IndiceHuellas indice = construirIndiceHuellas(texto, cortes, parametros, hilos);
+    auto t2 = HRClock::now();
+    std::vector<ParSimilar> pares = paresSimilares(indice, umbral, top, maxDocs, hilos);
+    auto t3 = HRClock::now();
+
+    auto ms = [](HRClock::time_point a, HRClock::time_point b)
+    { return std::chrono::duration_cast<std::chrono::milliseconds>(b - a).count(); };
+    std::cout << nombres.size() << " documentos, " << texto.size() << " caracteres (k = " << parametros.k
+              << ", ventana = " << parametros.ventana << ", max-docs = " << maxDocs << ", " << hilos << " hilos)\n";
+    std::cout << "  Lectura: " << ms(t0, t1) << " ms, huellas e indice: " << ms(t1, t2) << " ms ("
+              << indice.docs.size() << " huellas, " << indice.claves.size() << " distintas), pares: " << ms(t2, t3)
+              << " ms\n\n";
+
+    std::cout << "Pares mas parecidos (Jaccard / contencion / huellas comunes):\n";
+    for (const ParSimilar &p : pares)
+    {
+        std::cout << "  " << nombres[p.a] << " - " << nombres[p.b] << ": " << p.jaccard << " / " << p.contencion
+                  << " / " << p.comunes << "\n";
+    }
+    if (pares.empty())
+        std::cout << "  (ninguno)\n";
+    return 0;
+}
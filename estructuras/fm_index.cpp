@@ -0,0 +1,221 @@
+#include "fm_index.h"
+#include "suffix_array.h"
+#include <algorithm>
+
+static inline size_t contarUnos(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (x * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+const size_t PALABRAS_POR_BLOQUE = 8;
+
+size_t VectorBitsRank::rank1(size_t i) const {
+    size_t palabra = i >> 6;
+    size_t r = acumulado[palabra / PALABRAS_POR_BLOQUE];
+    for (size_t w = palabra - palabra % PALABRAS_POR_BLOQUE; w < palabra; ++w) r += contarUnos(palabras[w]);
+    if (i & 63) r += contarUnos(palabras[palabra] & ((1ULL << (i & 63)) - 1));
+    return r;
+}
+
+// Reserva n bits en cero (una palabra extra para que rank1(n) no se salga)
+static void iniciarBits(VectorBitsRank& v, size_t n) {
+    v.n = n;
+    v.palabras.assign(n / 64 + 1, 0);
+}
+
+static void marcarBit(VectorBitsRank& v, size_t i) {
+    v.palabras[i >> 6] |= 1ULL << (i & 63);
+}
+
+// Contadores acumulados por bloque, una vez llenos los bits
+static void prepararRank(VectorBitsRank& v) {
+    size_t bloques = v.palabras.size() / PALABRAS_POR_BLOQUE + 1;
+    v.acumulado.assign(bloques, 0);
+    size_t total = 0;
+    for (size_t w = 0; w < v.palabras.size(); ++w) {
+        if (w % PALABRAS_POR_BLOQUE == 0) v.acumulado[w / PALABRAS_POR_BLOQUE] = total;
+        total += contarUnos(v.palabras[w]);
+    }
+}
+
+// Cantidad del simbolo c en las filas [0, i) de la BWT
+template <typename Offset>
+static size_t rankSimbolo(const FMIndexT<Offset>& fm, unsigned char c, size_t i) {
+    size_t j = i;
+    for (int l = 0; l < 8; ++l) {
+        if ((c >> (7 - l)) & 1) j = fm.ceros[l] + fm.niveles[l].rank1(j);
+        else j = fm.niveles[l].rank0(j);
+    }
+    size_t r = j - fm.inicioSimbolo[c];
+    // El centinela se guarda como byte 0: no cuenta como ocurrencia de c = 0
+    if (c == 0 && i > fm.filaCentinela) --r;
+    return r;
+}
+
+// Paso LF: fila del sufijo que empieza una posicion antes. Lee el simbolo de
+// la fila y su rank en el mismo recorrido de la wavelet matrix.
+template <typename Offset>
+static size_t pasoLF(const FMIndexT<Offset>& fm, size_t fila) {
+    unsigned char c = 0;
+    size_t j = fila;
+    for (int l = 0; l < 8; ++l) {
+        bool b = fm.niveles[l].acceder(j);
+        c = (c << 1) | b;
+        j = b ? fm.ceros[l] + fm.niveles[l].rank1(j) : fm.niveles[l].rank0(j);
+    }
+    size_t r = j - fm.inicioSimbolo[c];
+    if (c == 0 && fila > fm.filaCentinela) --r;
+    return fm.C[c] + r;
+}
+
+template <typename Offset>
+FMIndexT<Offset> construirFMIndex(std::string_view texto, int pasoMuestreo) {
+    verificarTamTexto<Offset>(texto.size());
+    FMIndexT<Offset> fm;
+    size_t n = texto.size();
+    size_t filas = n + 1;
+    fm.n = n;
+    fm.pasoMuestreo = std::max(1, pasoMuestreo);
+
+    // BWT y muestras: la fila 0 es el sufijo vacio (el centinela, posicion n)
+    // y la fila i + 1 es sa[i]
+    std::vector<unsigned char> bwt(filas);
+    iniciarBits(fm.muestreada, filas);
+    {
+        std::vector<Offset> sa = construirSuffixArray<Offset>(texto);
+        for (size_t fila = 0; fila < filas; ++fila) {
+            size_t pos = fila == 0 ? n : (size_t)sa[fila - 1];
+            if (pos == 0) {
+                bwt[fila] = 0;
+                fm.filaCentinela = fila;
+            } else {
+                bwt[fila] = texto[pos - 1];
+            }
+            if (pos % fm.pasoMuestreo == 0) {
+                marcarBit(fm.muestreada, fila);
+                fm.muestras.push_back((Offset)pos);
+            }
+        }
+    }
+    prepararRank(fm.muestreada);
+
+    // C[c] = 1 (el centinela) + cantidad de bytes menores que c
+    std::array<uint64_t, 256> frecuencia{};
+    for (unsigned char c : texto) frecuencia[c]++;
+    fm.C[0] = 1;
+    for (int c = 0; c < 256; ++c) fm.C[c + 1] = fm.C[c] + frecuencia[c];
+
+    // Wavelet matrix: cada nivel guarda un bit y reordena de forma estable
+    // (ceros primero) para el nivel siguiente
+    std::vector<unsigned char> siguiente(filas);
+    for (int l = 0; l < 8; ++l) {
+        int bit = 7 - l;
+        VectorBitsRank& v = fm.niveles[l];
+        iniciarBits(v, filas);
+        size_t z = 0;
+        for (size_t i = 0; i < filas; ++i) {
+            if ((bwt[i] >> bit) & 1) marcarBit(v, i);
+            else ++z;
+        }
+        prepararRank(v);
+        fm.ceros[l] = z;
+
+        size_t a = 0, b = z;
+        for (size_t i = 0; i < filas; ++i) {
+            if ((bwt[i] >> bit) & 1) siguiente[b++] = bwt[i];
+            else siguiente[a++] = bwt[i];
+        }
+        bwt.swap(siguiente);
+    }
+
+    // Donde empieza cada simbolo en el ultimo nivel (rank desde la fila 0)
+    for (int c = 0; c < 256; ++c) {
+        size_t j = 0;
+        for (int l = 0; l < 8; ++l) {
+            if ((c >> (7 - l)) & 1) j = fm.ceros[l] + fm.niveles[l].rank1(j);
+            else j = fm.niveles[l].rank0(j);
+        }
+        fm.inicioSimbolo[c] = j;
+    }
+    return fm;
+}
+
+// Busqueda hacia atras: intervalo [sp, ep) de filas cuyos sufijos empiezan con el patron
+template <typename Offset>
+static bool intervaloFM(const FMIndexT<Offset>& fm, std::string_view patron, size_t& sp, size_t& ep) {
+    sp = 0;
+    ep = fm.n + 1;
+    if (patron.empty()) return false;
+    for (size_t k = patron.size(); k-- > 0 && sp < ep;) {
+        unsigned char c = patron[k];
+        sp = fm.C[c] + rankSimbolo(fm, c, sp);
+        ep = fm.C[c] + rankSimbolo(fm, c, ep);
+    }
+    return sp < ep;
+}
+
+// Posicion en el texto de una fila: pasos LF hasta una fila muestreada
+template <typename Offset>
+static size_t ubicarFila(const FMIndexT<Offset>& fm, size_t fila) {
+    size_t pasos = 0;
+    while (!fm.muestreada.acceder(fila)) {
+        fila = pasoLF(fm, fila);
+        ++pasos;
+    }
+    return (size_t)fm.muestras[fm.muestreada.rank1(fila)] + pasos;
+}
+
+template <typename Offset>
+size_t contarConFMIndex(const FMIndexT<Offset>& fm, std::string_view patron) {
+    size_t sp, ep;
+    return intervaloFM(fm, patron, sp, ep) ? ep - sp : 0;
+}
+
+template <typename Offset>
+void buscarConFMIndex(const FMIndexT<Offset>& fm, std::string_view patron, SumideroResultadosT<Offset>& sumidero) {
+    size_t sp, ep;
+    if (!intervaloFM(fm, patron, sp, ep)) return;
+    if (sumidero.modo == ModoResultado::Contar) {
+        sumidero.cuenta += ep - sp;
+        return;
+    }
+    for (size_t fila = sp; fila < ep; ++fila) {
+        if (!sumidero.reportar(ubicarFila(fm, fila))) return;
+    }
+}
+
+template <typename Offset>
+std::vector<Offset> buscarConFMIndex(const FMIndexT<Offset>& fm, std::string_view patron) {
+    std::vector<Offset> resultado;
+    SumideroResultadosT<Offset> sumidero = sumideroAgregar(resultado);
+    buscarConFMIndex(fm, patron, sumidero);
+    return resultado;
+}
+
+static size_t bytesVector(const VectorBitsRank& v) {
+    return (v.palabras.size() + v.acumulado.size()) * sizeof(uint64_t);
+}
+
+template <typename Offset>
+size_t bytesFMIndex(const FMIndexT<Offset>& fm) {
+    size_t total = sizeof(fm) + bytesVector(fm.muestreada) + fm.muestras.size() * sizeof(Offset);
+    for (const auto& v : fm.niveles) total += bytesVector(v);
+    return total;
+}
+
+template FMIndexT<Offset32> construirFMIndex<Offset32>(std::string_view, int);
+template FMIndexT<Offset64> construirFMIndex<Offset64>(std::string_view, int);
+template size_t contarConFMIndex<Offset32>(const FMIndexT<Offset32>&, std::string_view);
+template size_t contarConFMIndex<Offset64>(const FMIndexT<Offset64>&, std::string_view);
+template std::vector<Offset32> buscarConFMIndex<Offset32>(const FMIndexT<Offset32>&, std::string_view);
+template std::vector<Offset64> buscarConFMIndex<Offset64>(const FMIndexT<Offset64>&, std::string_view);
+template void buscarConFMIndex<Offset32>(const FMIndexT<Offset32>&, std::string_view, SumideroResultados&);
+template void buscarConFMIndex<Offset64>(const FMIndexT<Offset64>&, std::string_view, SumideroResultados64&);
+template size_t bytesFMIndex<Offset32>(const FMIndexT<Offset32>&);
+template size_t bytesFMIndex<Offset64>(const FMIndexT<Offset64>&);
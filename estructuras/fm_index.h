@@ -0,0 +1,72 @@
+#ifndef FM_INDEX_H
+#define FM_INDEX_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "resultados.h"
+
+// Vector de bits con rank en tiempo constante: un contador acumulado cada
+// bloque de 8 palabras (512 bits) y popcount dentro del bloque
+struct VectorBitsRank {
+    std::vector<uint64_t> palabras;
+    std::vector<uint64_t> acumulado; // unos antes de cada bloque
+    size_t n = 0;
+
+    bool acceder(size_t i) const { return (palabras[i >> 6] >> (i & 63)) & 1; }
+
+    // Cantidad de unos en [0, i)
+    size_t rank1(size_t i) const;
+    size_t rank0(size_t i) const { return i - rank1(i); }
+};
+
+// FM-index: BWT del texto (con un centinela virtual menor que todo byte)
+// guardada en una wavelet matrix de 8 niveles, mas el suffix array muestreado
+// cada 'pasoMuestreo' posiciones del texto para ubicar las coincidencias.
+// Contar es una busqueda hacia atras en O(m) rank y nunca mira el texto
+// original; ubicar cuesta ademas hasta pasoMuestreo pasos LF por coincidencia.
+// Offset es el ancho de las muestras (Offset64 para textos de mas de 2 GiB).
+template <typename Offset>
+struct FMIndexT {
+    size_t n = 0;               // largo del texto (la BWT tiene n + 1 filas)
+    size_t filaCentinela = 0;   // fila de la BWT que contiene el centinela
+    std::array<uint64_t, 257> C{}; // primera fila de los sufijos que empiezan con cada byte
+
+    // Wavelet matrix: nivel l = bit (7 - l) de cada simbolo
+    VectorBitsRank niveles[8];
+    size_t ceros[8] = {};
+    std::array<uint64_t, 256> inicioSimbolo{}; // inicio de cada simbolo en el ultimo nivel
+
+    // Suffix array muestreado: filas marcadas y su posicion en el texto
+    int pasoMuestreo = 32;
+    VectorBitsRank muestreada;
+    std::vector<Offset> muestras;
+};
+using FMIndex = FMIndexT<Offset32>;
+using FMIndex64 = FMIndexT<Offset64>;
+
+// Construye el FM-index (a partir del suffix array, que se descarta al final)
+template <typename Offset = Offset32>
+FMIndexT<Offset> construirFMIndex(std::string_view texto, int pasoMuestreo = 32);
+
+// Cantidad de ocurrencias del patron (busqueda hacia atras, sin el texto)
+template <typename Offset>
+size_t contarConFMIndex(const FMIndexT<Offset>& fm, std::string_view patron);
+
+// Posiciones del patron (en orden de la BWT, como buscarConSuffixArray)
+template <typename Offset>
+std::vector<Offset> buscarConFMIndex(const FMIndexT<Offset>& fm, std::string_view patron);
+
+// Entrega las posiciones al sumidero. Para solo contar no ubica nada: la
+// cantidad es el tamaño del intervalo de la BWT.
+template <typename Offset>
+void buscarConFMIndex(const FMIndexT<Offset>& fm, std::string_view patron, SumideroResultadosT<Offset>& sumidero);
+
+// Bytes que ocupa el indice en memoria (sin el texto, que no necesita)
+template <typename Offset>
+size_t bytesFMIndex(const FMIndexT<Offset>& fm);
+
+#endif
@@ -0,0 +1,293 @@
+#include "indice_persistente.h"
+#include "io.h"
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char MAGIA_INDICE[8] = {'D', 'P', 'S', 'A', 'I', 'D', 'X', '1'};
+static const uint32_t VERSION_INDICE = 1;
+
+static_assert(sizeof(Offset32) == 4 && sizeof(Offset64) == 8, "el formato del indice usa enteros de 32 y 64 bits");
+
+static uint64_t alinear8(uint64_t x)
+{
+    return (x + 7) & ~uint64_t(7);
+}
+
+// Escribe 'n' bytes y rellena con ceros hasta el siguiente multiplo de 8
+static void escribirSeccion(std::ofstream &out, const void *datos, uint64_t n)
+{
+    static const char ceros[8] = {};
+    out.write(static_cast<const char *>(datos), n);
+    out.write(ceros, alinear8(n) - n);
+}
+
+template <typename Offset>
+bool guardarIndice(const std::string &ruta,
+                   std::string_view texto,
+                   const std::vector<Offset> &sa,
+                   const LCPBusquedaT<Offset> &lcp,
+                   const std::vector<int64_t> &cortes64,
+                   const std::vector<std::string> &nombresDoc,
+                   uint64_t checksum)
+{
+    std::vector<Offset> cortes(cortes64.begin(), cortes64.end());
+
+    // Nombres: offsets de inicio (numDocs + 1) y bytes concatenados
+    std::vector<int> inicioNombres(nombresDoc.size() + 1, 0);
+    std::string nombres;
+    for (size_t i = 0; i < nombresDoc.size(); ++i)
+    {
+        nombres += nombresDoc[i];
+        inicioNombres[i + 1] = nombres.size();
+    }
+
+    uint64_t n = texto.size();
+    CabeceraIndice cab{};
+    std::memcpy(cab.magia, MAGIA_INDICE, sizeof(cab.magia));
+    cab.version = VERSION_INDICE;
+    cab.bytesEntero = sizeof(Offset);
+    cab.checksum = checksum;
+    cab.tamTexto = n;
+    cab.numDocs = cortes.size();
+    cab.offTexto = alinear8(sizeof(CabeceraIndice));
+    cab.offSA = cab.offTexto + alinear8(n);
+    cab.offLCPIzq = cab.offSA + alinear8(n * sizeof(Offset));
+    cab.offLCPDer = cab.offLCPIzq + alinear8(n * sizeof(Offset));
+    cab.offCortes = cab.offLCPDer + alinear8(n * sizeof(Offset));
+    cab.offInicioNombres = cab.offCortes + alinear8(cortes.size() * sizeof(Offset));
+    cab.offNombres = cab.offInicioNombres + alinear8(inicioNombres.size() * sizeof(int));
+    cab.tamArchivo = cab.offNombres + alinear8(nombres.size());
+
+    // Se escribe en un temporal y se renombra encima: otros procesos que
+    // tengan mapeado el indice anterior lo siguen viendo entero (truncarlo
+    // en el lugar les daria SIGBUS o lecturas a medias)
+    std::string temporal = ruta + ".tmp";
+    std::ofstream out(temporal, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::cerr << "Error: No se pudo crear el indice " << temporal << std::endl;
+        return false;
+    }
+
+    escribirSeccion(out, &cab, sizeof(cab));
+    escribirSeccion(out, texto.data(), n);
+    escribirSeccion(out, sa.data(), n * sizeof(Offset));
+    escribirSeccion(out, lcp.izq.data(), n * sizeof(Offset));
+    escribirSeccion(out, lcp.der.data(), n * sizeof(Offset));
+    escribirSeccion(out, cortes.data(), cortes.size() * sizeof(Offset));
+    escribirSeccion(out, inicioNombres.data(), inicioNombres.size() * sizeof(int));
+    escribirSeccion(out, nombres.data(), nombres.size());
+    out.close();
+    if (out.fail())
+    {
+        std::cerr << "Error: No se pudo escribir el indice " << temporal << std::endl;
+        std::remove(temporal.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    bool reemplazado = MoveFileExA(temporal.c_str(), ruta.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    bool reemplazado = std::rename(temporal.c_str(), ruta.c_str()) == 0;
+#endif
+    if (!reemplazado)
+    {
+        std::cerr << "Error: No se pudo reemplazar el indice " << ruta << std::endl;
+        std::remove(temporal.c_str());
+        return false;
+    }
+    return true;
+}
+
+template bool guardarIndice<Offset32>(const std::string &, std::string_view, const std::vector<Offset32> &,
+                                      const LCPBusqueda &, const std::vector<int64_t> &,
+                                      const std::vector<std::string> &, uint64_t);
+template bool guardarIndice<Offset64>(const std::string &, std::string_view, const std::vector<Offset64> &,
+                                      const LCPBusqueda64 &, const std::vector<int64_t> &,
+                                      const std::vector<std::string> &, uint64_t);
+
+// Construye SA + LCP con el ancho de offset dado y guarda el indice
+template <typename Offset>
+static bool construirYGuardar(const std::string &ruta, const Corpus &corpus, uint64_t checksum, int hilos,
+                              MetodoSA metodo)
+{
+    std::string_view texto = corpus.texto();
+    std::vector<Offset> sa = construirSuffixArray<Offset>(texto, metodo, hilos);
+    LCPBusquedaT<Offset> lcp = construirLCPBusqueda(construirLCP(texto, sa));
+    return guardarIndice(ruta, texto, sa, lcp, corpus.cortes, corpus.nombres, checksum);
+}
+
+bool generarIndice(const std::string &carpeta, const std::string &ruta, int hilos, MetodoSA metodo)
+{
+    // La huella se toma antes de leer: si el corpus cambia durante la
+    // construccion, el indice queda marcado como desactualizado
+    uint64_t checksum = checksumCorpus(carpeta);
+
+    Corpus corpus;
+    cargarCorpus(carpeta, corpus, hilos);
+
+    // 32 bits mientras el texto quepa: la mitad de memoria y de disco
+    if (necesitaOffset64(corpus.tam))
+        return construirYGuardar<Offset64>(ruta, corpus, checksum, hilos, metodo);
+    return construirYGuardar<Offset32>(ruta, corpus, checksum, hilos, metodo);
+}
+
+std::string_view IndiceMapeado::nombre(size_t i) const
+{
+    return std::string_view(nombres + inicioNombres[i], inicioNombres[i + 1] - inicioNombres[i]);
+}
+
+IndiceMapeado::~IndiceMapeado()
+{
+    liberarIndice(*this);
+}
+
+void liberarIndice(IndiceMapeado &indice)
+{
+    if (indice.base)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(indice.base);
+        CloseHandle(indice.mapeo);
+        CloseHandle(indice.archivo);
+        indice.mapeo = nullptr;
+        indice.archivo = nullptr;
+#else
+        munmap(const_cast<char *>(indice.base), indice.tamMapeo);
+#endif
+    }
+    indice.base = nullptr;
+    indice.tamMapeo = 0;
+    indice.texto = std::string_view();
+    indice.a32 = ArreglosIndice<Offset32>();
+    indice.a64 = ArreglosIndice<Offset64>();
+    indice.offset64 = false;
+    indice.inicioNombres = nullptr;
+    indice.nombres = nullptr;
+    indice.numDocs = 0;
+    indice.checksum = 0;
+}
+
+// Verifica que la seccion [off, off + bytes) este alineada y dentro del archivo
+static bool seccionValida(uint64_t off, uint64_t bytes, uint64_t tam)
+{
+    return off % 8 == 0 && off <= tam && bytes <= tam - off;
+}
+
+template <typename Offset>
+static void mapearArreglos(const char *b, const CabeceraIndice &cab, ArreglosIndice<Offset> &a)
+{
+    a.sa = reinterpret_cast<const Offset *>(b + cab.offSA);
+    a.lcpIzq = reinterpret_cast<const Offset *>(b + cab.offLCPIzq);
+    a.lcpDer = reinterpret_cast<const Offset *>(b + cab.offLCPDer);
+    a.cortes = reinterpret_cast<const Offset *>(b + cab.offCortes);
+}
+
+bool cargarIndice(const std::string &ruta, IndiceMapeado &indice)
+{
+    liberarIndice(indice);
+
+#ifdef _WIN32
+    HANDLE archivo = CreateFileA(ruta.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (archivo == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER tamArchivo;
+    if (!GetFileSizeEx(archivo, &tamArchivo) || tamArchivo.QuadPart < (LONGLONG)sizeof(CabeceraIndice))
+    {
+        CloseHandle(archivo);
+        return false;
+    }
+    HANDLE mapeo = CreateFileMappingA(archivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapeo)
+    {
+        CloseHandle(archivo);
+        return false;
+    }
+    void *base = MapViewOfFile(mapeo, FILE_MAP_READ, 0, 0, 0);
+    if (!base)
+    {
+        CloseHandle(mapeo);
+        CloseHandle(archivo);
+        return false;
+    }
+    indice.archivo = archivo;
+    indice.mapeo = mapeo;
+    uint64_t tam = tamArchivo.QuadPart;
+#else
+    int fd = open(ruta.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(CabeceraIndice))
+    {
+        close(fd);
+        return false;
+    }
+    uint64_t tam = st.st_size;
+    void *base = mmap(nullptr, tam, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        return false;
+#endif
+
+    indice.base = static_cast<const char *>(base);
+    indice.tamMapeo = tam;
+
+    CabeceraIndice cab;
+    std::memcpy(&cab, indice.base, sizeof(cab));
+    uint64_t n = cab.tamTexto, d = cab.numDocs, w = cab.bytesEntero;
+    bool valido = std::memcmp(cab.magia, MAGIA_INDICE, sizeof(cab.magia)) == 0 &&
+                  cab.version == VERSION_INDICE &&
+                  (w == sizeof(Offset32) || w == sizeof(Offset64)) &&
+                  cab.tamArchivo == tam &&
+                  (w == sizeof(Offset64) || n <= (uint64_t)INT32_MAX) && d <= (uint64_t)INT32_MAX &&
+                  n <= tam && d <= tam &&
+                  seccionValida(cab.offTexto, n, tam) &&
+                  seccionValida(cab.offSA, n * w, tam) &&
+                  seccionValida(cab.offLCPIzq, n * w, tam) &&
+                  seccionValida(cab.offLCPDer, n * w, tam) &&
+                  seccionValida(cab.offCortes, d * w, tam) &&
+                  seccionValida(cab.offInicioNombres, (d + 1) * sizeof(int), tam);
+    if (valido)
+    {
+        // nombre(i) confia en todos los inicios: deben empezar en 0, no
+        // decrecer y terminar dentro de la seccion de nombres (O(d), sin
+        // tocar el texto ni el SA)
+        const int *inicioNombres = reinterpret_cast<const int *>(indice.base + cab.offInicioNombres);
+        valido = inicioNombres[0] == 0;
+        for (uint64_t i = 0; valido && i < d; ++i)
+            valido = inicioNombres[i] <= inicioNombres[i + 1];
+        valido = valido && seccionValida(cab.offNombres, (uint64_t)inicioNombres[d], tam);
+    }
+    if (!valido)
+    {
+        std::cerr << "Error: Indice invalido o de otra version: " << ruta << std::endl;
+        liberarIndice(indice);
+        return false;
+    }
+
+    const char *b = indice.base;
+    indice.texto = std::string_view(b + cab.offTexto, n);
+    indice.offset64 = w == sizeof(Offset64);
+    if (indice.offset64)
+        mapearArreglos(b, cab, indice.a64);
+    else
+        mapearArreglos(b, cab, indice.a32);
+    indice.inicioNombres = reinterpret_cast<const int *>(b + cab.offInicioNombres);
+    indice.nombres = b + cab.offNombres;
+    indice.numDocs = d;
+    indice.checksum = cab.checksum;
+    return true;
+}
@@ -0,0 +1,114 @@
+#ifndef INDICE_PERSISTENTE_H
+#define INDICE_PERSISTENTE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "suffix_array.h"
+
+// Formato en disco del indice (todas las secciones alineadas a 8 bytes):
+//   cabecera | texto | SA | LCP izq | LCP der | cortes | inicio de nombres | nombres
+// Los arreglos (SA, LCP y cortes) se guardan como int32, o como int64 si el
+// texto no cabe en 32 bits ('bytesEntero' indica el ancho), en el orden de
+// bytes de la maquina, asi el archivo se usa directamente despues de
+// mapearlo, sin parseo ni copias. El inicio de los nombres es siempre int32.
+struct CabeceraIndice
+{
+    char magia[8];
+    uint32_t version;
+    uint32_t bytesEntero;
+    uint64_t checksum;
+    uint64_t tamTexto;
+    uint64_t numDocs;
+    uint64_t offTexto;
+    uint64_t offSA;
+    uint64_t offLCPIzq;
+    uint64_t offLCPDer;
+    uint64_t offCortes;
+    uint64_t offInicioNombres;
+    uint64_t offNombres;
+    uint64_t tamArchivo;
+};
+
+// Arreglos del indice mapeado, con el ancho de offset del archivo
+template <typename Offset>
+struct ArreglosIndice
+{
+    const Offset *sa = nullptr;
+    const Offset *lcpIzq = nullptr;
+    const Offset *lcpDer = nullptr;
+    const Offset *cortes = nullptr;
+};
+
+// Indice de solo lectura mapeado en memoria. Varios procesos que abren el mismo
+// archivo comparten las paginas del cache del sistema operativo.
+struct IndiceMapeado
+{
+    std::string_view texto;
+    bool offset64 = false; // los arreglos validos son a64 (si no, a32)
+    ArreglosIndice<Offset32> a32;
+    ArreglosIndice<Offset64> a64;
+    size_t numDocs = 0;
+    uint64_t checksum = 0;
+
+    // Arreglos con el ancho indicado (debe coincidir con offset64)
+    template <typename Offset>
+    const ArreglosIndice<Offset> &arreglos() const
+    {
+        if constexpr (std::is_same_v<Offset, Offset64>)
+            return a64;
+        else
+            return a32;
+    }
+
+    // Nombre del documento i (base 0)
+    std::string_view nombre(size_t i) const;
+
+    IndiceMapeado() = default;
+    ~IndiceMapeado();
+    IndiceMapeado(const IndiceMapeado &) = delete;
+    IndiceMapeado &operator=(const IndiceMapeado &) = delete;
+
+    // Estado interno del mapeo
+    const char *base = nullptr;
+    size_t tamMapeo = 0;
+    const int *inicioNombres = nullptr;
+    const char *nombres = nullptr;
+#ifdef _WIN32
+    void *archivo = nullptr;
+    void *mapeo = nullptr;
+#endif
+};
+
+// Escribe el indice completo en 'ruta' con arreglos de Offset32 u Offset64.
+// Se escribe en 'ruta' + ".tmp" y se renombra encima de 'ruta', asi quien
+// tenga mapeado el indice anterior no lo ve truncado. Devuelve false si no se
+// pudo escribir o reemplazar.
+template <typename Offset>
+bool guardarIndice(const std::string &ruta,
+                   std::string_view texto,
+                   const std::vector<Offset> &sa,
+                   const LCPBusquedaT<Offset> &lcp,
+                   const std::vector<int64_t> &cortes,
+                   const std::vector<std::string> &nombresDoc,
+                   uint64_t checksum);
+
+// Lee los documentos de 'carpeta', construye SA + LCP y guarda el indice
+// (con offsets de 64 bits solo si el texto no cabe en 32). 'hilos' reparte
+// la lectura de los documentos; el suffix array se arma con SA-IS salvo que se
+// pida otro metodo (DuplicacionParalela usa los mismos hilos, pero por nucleo
+// es varias veces mas lenta que SA-IS). El indice resultante es el mismo.
+bool generarIndice(const std::string &carpeta, const std::string &ruta, int hilos = 1,
+                   MetodoSA metodo = MetodoSA::SAIS);
+
+// Mapea el indice de 'ruta' (solo valida la cabecera y los limites de cada seccion)
+bool cargarIndice(const std::string &ruta, IndiceMapeado &indice);
+
+// Libera el mapeo (tambien lo hace el destructor)
+void liberarIndice(IndiceMapeado &indice);
+
+#endif
@@ -0,0 +1,434 @@
+#include "indice_segmentado.h"
+#include "io.h"
+#include "paralelo.h"
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+
+// Tamaño maximo de un segmento: sus offsets siempre caben en Offset32
+const size_t TAM_MAX_SEGMENTO = size_t(1) << 30;
+
+// Los segmentos de nivel 0 miden hasta TAM_BASE_SEGMENTO; cada nivel siguiente
+// es FACTOR_FUSION veces mas grande, y FACTOR_FUSION segmentos de un nivel se
+// fusionan en uno del siguiente
+const size_t TAM_BASE_SEGMENTO = 1 << 16;
+const size_t FACTOR_FUSION = 4;
+
+static int nivelSegmento(size_t tam)
+{
+    int nivel = 0;
+    for (size_t limite = TAM_BASE_SEGMENTO; tam > limite; limite *= FACTOR_FUSION)
+        ++nivel;
+    return nivel;
+}
+
+// Concatena los documentos (ids crecientes) y construye el SA del segmento
+static std::shared_ptr<const SegmentoIndice> construirSegmento(const std::vector<std::string_view> &contenidos,
+                                                               const std::vector<int> &docIds)
+{
+    auto segmento = std::make_shared<SegmentoIndice>();
+    size_t total = 0;
+    for (std::string_view c : contenidos)
+        total += c.size() + 1;
+    segmento->texto.reserve(total);
+    for (std::string_view c : contenidos)
+    {
+        segmento->texto.append(c);
+        segmento->texto.push_back('$');
+        segmento->cortes.push_back((Offset32)segmento->texto.size());
+    }
+    segmento->docIds = docIds;
+    segmento->sa = construirSuffixArray<Offset32>(segmento->texto);
+    segmento->lcp = construirLCPBusqueda(construirLCP(segmento->texto, segmento->sa));
+    return segmento;
+}
+
+// Contenido del documento local i del segmento (sin el '$' final)
+static std::string_view documentoSegmento(const SegmentoIndice &s, size_t i)
+{
+    size_t inicio = i == 0 ? 0 : s.cortes[i - 1];
+    return std::string_view(s.texto).substr(inicio, s.cortes[i] - 1 - inicio);
+}
+
+static void avisarCambios(IndiceSegmentado &indice)
+{
+    {
+        std::lock_guard<std::mutex> lock(indice.mutexAviso);
+        indice.hayCambios = true;
+    }
+    indice.aviso.notify_one();
+}
+
+static int agregarVistas(IndiceSegmentado &indice,
+                         const std::vector<std::string> &nombres,
+                         const std::vector<std::string_view> &contenidos)
+{
+    for (std::string_view c : contenidos)
+    {
+        if (c.size() + 1 > TAM_MAX_SEGMENTO)
+            return -1;
+    }
+    if (contenidos.empty())
+        return -1;
+
+    // Reservar los ids; los documentos no aparecen en las consultas hasta
+    // publicar sus segmentos
+    int primero;
+    {
+        std::unique_lock<std::shared_mutex> lock(indice.mutex);
+        primero = (int)indice.nombres.size();
+        indice.nombres.insert(indice.nombres.end(), nombres.begin(), nombres.end());
+        indice.borrado.resize(indice.nombres.size(), 0);
+    }
+
+    // Cortar el lote en segmentos de a lo sumo TAM_MAX_SEGMENTO y construirlos
+    // sin tomar el candado
+    std::vector<std::shared_ptr<const SegmentoIndice>> nuevos;
+    std::vector<std::string_view> trozo;
+    std::vector<int> ids;
+    size_t tam = 0;
+    for (size_t i = 0; i <= contenidos.size(); ++i)
+    {
+        if (!trozo.empty() && (i == contenidos.size() || tam + contenidos[i].size() + 1 > TAM_MAX_SEGMENTO))
+        {
+            nuevos.push_back(construirSegmento(trozo, ids));
+            trozo.clear();
+            ids.clear();
+            tam = 0;
+        }
+        if (i < contenidos.size())
+        {
+            trozo.push_back(contenidos[i]);
+            ids.push_back(primero + (int)i);
+            tam += contenidos[i].size() + 1;
+        }
+    }
+
+    // Publicar: las versiones anteriores de los mismos nombres se borran a la vez
+    {
+        std::unique_lock<std::shared_mutex> lock(indice.mutex);
+        indice.segmentos.insert(indice.segmentos.end(), nuevos.begin(), nuevos.end());
+        for (size_t i = 0; i < nombres.size(); ++i)
+        {
+            auto [it, insertado] = indice.idPorNombre.try_emplace(nombres[i], primero + (int)i);
+            if (!insertado)
+            {
+                indice.borrado[it->second] = 1;
+                it->second = primero + (int)i;
+            }
+        }
+    }
+    avisarCambios(indice);
+    return primero;
+}
+
+int agregarDocumentos(IndiceSegmentado &indice,
+                      const std::vector<std::string> &nombres,
+                      const std::vector<std::string> &contenidos)
+{
+    std::vector<std::string_view> vistas(contenidos.begin(), contenidos.end());
+    return agregarVistas(indice, nombres, vistas);
+}
+
+bool eliminarDocumento(IndiceSegmentado &indice, int doc)
+{
+    {
+        std::unique_lock<std::shared_mutex> lock(indice.mutex);
+        if (doc < 0 || doc >= (int)indice.borrado.size() || indice.borrado[doc])
+            return false;
+        indice.borrado[doc] = 1;
+        auto it = indice.idPorNombre.find(indice.nombres[doc]);
+        if (it != indice.idPorNombre.end() && it->second == doc)
+            indice.idPorNombre.erase(it);
+    }
+    avisarCambios(indice);
+    return true;
+}
+
+bool eliminarDocumento(IndiceSegmentado &indice, const std::string &nombre)
+{
+    int doc;
+    {
+        std::shared_lock<std::shared_mutex> lock(indice.mutex);
+        auto it = indice.idPorNombre.find(nombre);
+        if (it == indice.idPorNombre.end())
+            return false;
+        doc = it->second;
+    }
+    return eliminarDocumento(indice, doc);
+}
+
+size_t sincronizarCarpeta(IndiceSegmentado &indice, const std::string &carpeta, int hilos)
+{
+    auto huellas = huellasDocumentos(carpeta);
+
+    std::vector<std::string> nuevos;
+    std::vector<uint64_t> huellasNuevas;
+    std::vector<int> borrar;
+    {
+        std::shared_lock<std::shared_mutex> lock(indice.mutex);
+        std::unordered_set<std::string> presentes;
+        for (const auto &[nombre, huella] : huellas)
+        {
+            presentes.insert(nombre);
+            auto h = indice.huellas.find(nombre);
+            if (!indice.idPorNombre.count(nombre) || h == indice.huellas.end() || h->second != huella)
+            {
+                nuevos.push_back(nombre);
+                huellasNuevas.push_back(huella);
+            }
+        }
+        for (const auto &[nombre, id] : indice.idPorNombre)
+        {
+            if (!presentes.count(nombre))
+                borrar.push_back(id);
+        }
+    }
+
+    size_t cambios = 0;
+    for (int id : borrar)
+        cambios += eliminarDocumento(indice, id);
+
+    if (nuevos.empty())
+        return cambios;
+
+    // Un solo lote con todos los documentos nuevos o modificados. Si alguno
+    // desaparecio mientras se leia, se reintenta en la proxima sincronizacion.
+    std::vector<int64_t> cortes;
+    std::string texto = concatenarDocumentosSeleccionados(carpeta, nuevos, cortes, hilos);
+    if (cortes.size() != nuevos.size())
+        return cambios;
+
+    std::vector<std::string_view> contenidos;
+    for (size_t i = 0; i < cortes.size(); ++i)
+    {
+        int64_t inicio = i == 0 ? 0 : cortes[i - 1];
+        contenidos.push_back(std::string_view(texto).substr(inicio, cortes[i] - 1 - inicio));
+    }
+    if (agregarVistas(indice, nuevos, contenidos) < 0)
+        return cambios;
+
+    std::unique_lock<std::shared_mutex> lock(indice.mutex);
+    for (size_t i = 0; i < nuevos.size(); ++i)
+        indice.huellas[nuevos[i]] = huellasNuevas[i];
+    return cambios + nuevos.size();
+}
+
+static bool antesQue(const CoincidenciaSegmentada &a, const CoincidenciaSegmentada &b)
+{
+    return a.doc != b.doc ? a.doc < b.doc : a.offset < b.offset;
+}
+
+// Coincidencias de un segmento, ya ordenadas por documento y offset (los ids
+// del segmento son crecientes)
+static std::vector<CoincidenciaSegmentada> buscarEnSegmento(const SegmentoIndice &s, std::string_view patron,
+                                                            const std::vector<char> &borrado)
+{
+    std::vector<Offset32> pos = buscarConSuffixArray(s.texto, patron, s.sa, s.lcp);
+    std::sort(pos.begin(), pos.end());
+
+    std::vector<CoincidenciaSegmentada> resultado;
+    for (const UbicacionDoc &u : ubicarEnDocumentos(pos, s.cortes.data(), s.cortes.size()))
+    {
+        if (u.doc < 0)
+            continue;
+        int doc = s.docIds[u.doc - 1];
+        if (!borrado[doc])
+            resultado.push_back({doc, u.offset});
+    }
+    return resultado;
+}
+
+std::vector<CoincidenciaSegmentada> buscarEnIndiceSegmentado(const IndiceSegmentado &indice,
+                                                             std::string_view patron, int hilos)
+{
+    std::vector<CoincidenciaSegmentada> resultado;
+    if (patron.empty())
+        return resultado;
+
+    std::shared_lock<std::shared_mutex> lock(indice.mutex);
+    std::vector<std::vector<CoincidenciaSegmentada>> parciales(indice.segmentos.size());
+    paraleloPara(indice.segmentos.size(), hilos, [&](size_t i)
+                 { parciales[i] = buscarEnSegmento(*indice.segmentos[i], patron, indice.borrado); });
+
+    // Mezcla de las S listas ordenadas en una sola pasada: un heap con el
+    // cursor de cada lista no vacia, O(n log S) en vez de S mezclas sucesivas
+    size_t total = 0;
+    std::vector<std::pair<size_t, size_t>> cursores; // (lista, posicion)
+    for (size_t i = 0; i < parciales.size(); ++i)
+    {
+        total += parciales[i].size();
+        if (!parciales[i].empty())
+            cursores.push_back({i, 0});
+    }
+    resultado.reserve(total);
+    auto despues = [&](const std::pair<size_t, size_t> &a, const std::pair<size_t, size_t> &b)
+    { return antesQue(parciales[b.first][b.second], parciales[a.first][a.second]); };
+    std::make_heap(cursores.begin(), cursores.end(), despues);
+    while (!cursores.empty())
+    {
+        std::pop_heap(cursores.begin(), cursores.end(), despues);
+        auto &[lista, pos] = cursores.back();
+        resultado.push_back(parciales[lista][pos]);
+        if (++pos < parciales[lista].size())
+            std::push_heap(cursores.begin(), cursores.end(), despues);
+        else
+            cursores.pop_back();
+    }
+    return resultado;
+}
+
+// Elige los segmentos a compactar: el primero con mas de la mitad de sus
+// documentos borrados, o si no el nivel mas bajo con FACTOR_FUSION segmentos
+// (los mas chicos primero, sin pasar TAM_MAX_SEGMENTO)
+static std::vector<std::shared_ptr<const SegmentoIndice>> elegirSegmentos(const IndiceSegmentado &indice)
+{
+    std::map<int, std::vector<std::shared_ptr<const SegmentoIndice>>> porNivel;
+    for (const auto &s : indice.segmentos)
+    {
+        size_t borrados = 0;
+        for (int doc : s->docIds)
+            borrados += indice.borrado[doc];
+        if (2 * borrados > s->docIds.size())
+            return {s};
+        porNivel[nivelSegmento(s->texto.size())].push_back(s);
+    }
+
+    for (auto &[nivel, grupo] : porNivel)
+    {
+        if (grupo.size() < FACTOR_FUSION)
+            continue;
+        std::sort(grupo.begin(), grupo.end(), [](const auto &a, const auto &b)
+                  { return a->texto.size() < b->texto.size(); });
+        std::vector<std::shared_ptr<const SegmentoIndice>> elegidos;
+        size_t tam = 0;
+        for (const auto &s : grupo)
+        {
+            if (tam + s->texto.size() > TAM_MAX_SEGMENTO)
+                break;
+            tam += s->texto.size();
+            elegidos.push_back(s);
+        }
+        if (elegidos.size() >= 2)
+            return elegidos;
+    }
+    return {};
+}
+
+bool compactarSegmentos(IndiceSegmentado &indice)
+{
+    std::lock_guard<std::mutex> fusion(indice.mutexFusion);
+
+    // Elegir y anotar los documentos vigentes (id, segmento, posicion local)
+    std::vector<std::shared_ptr<const SegmentoIndice>> elegidos;
+    std::vector<std::tuple<int, const SegmentoIndice *, size_t>> docs;
+    {
+        std::shared_lock<std::shared_mutex> lock(indice.mutex);
+        elegidos = elegirSegmentos(indice);
+        for (const auto &s : elegidos)
+        {
+            for (size_t i = 0; i < s->docIds.size(); ++i)
+            {
+                if (!indice.borrado[s->docIds[i]])
+                    docs.emplace_back(s->docIds[i], s.get(), i);
+            }
+        }
+    }
+    if (elegidos.empty())
+        return false;
+
+    // Construir el segmento fusionado fuera del candado, con ids crecientes
+    std::sort(docs.begin(), docs.end());
+    std::vector<std::string_view> contenidos;
+    std::vector<int> ids;
+    for (const auto &[id, s, i] : docs)
+    {
+        contenidos.push_back(documentoSegmento(*s, i));
+        ids.push_back(id);
+    }
+    std::shared_ptr<const SegmentoIndice> fusionado;
+    if (!docs.empty())
+        fusionado = construirSegmento(contenidos, ids);
+
+    // Reemplazar los elegidos; los documentos borrados mientras tanto siguen
+    // con su lapida, que vale tambien en el segmento nuevo
+    std::unique_lock<std::shared_mutex> lock(indice.mutex);
+    auto &segs = indice.segmentos;
+    auto primero = std::find(segs.begin(), segs.end(), elegidos[0]);
+    size_t posicion = primero - segs.begin();
+    segs.erase(std::remove_if(segs.begin(), segs.end(), [&](const auto &s)
+                              { return std::find(elegidos.begin(), elegidos.end(), s) != elegidos.end(); }),
+               segs.end());
+    if (fusionado)
+        segs.insert(segs.begin() + std::min(posicion, segs.size()), fusionado);
+    indice.compactaciones++;
+    return true;
+}
+
+static bool hayQueDetener(IndiceSegmentado &indice)
+{
+    std::lock_guard<std::mutex> lock(indice.mutexAviso);
+    return indice.detener;
+}
+
+void iniciarCompactacion(IndiceSegmentado &indice)
+{
+    if (indice.compactador.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(indice.mutexAviso);
+        indice.detener = false;
+        indice.hayCambios = true;
+    }
+    indice.compactador = std::thread([&indice]()
+                                     {
+        std::unique_lock<std::mutex> lock(indice.mutexAviso);
+        while (true)
+        {
+            indice.aviso.wait(lock, [&]() { return indice.hayCambios || indice.detener; });
+            if (indice.detener)
+                return;
+            indice.hayCambios = false;
+            lock.unlock();
+            while (!hayQueDetener(indice) && compactarSegmentos(indice))
+            {
+            }
+            lock.lock();
+        } });
+}
+
+void detenerCompactacion(IndiceSegmentado &indice)
+{
+    {
+        std::lock_guard<std::mutex> lock(indice.mutexAviso);
+        indice.detener = true;
+    }
+    indice.aviso.notify_one();
+    if (indice.compactador.joinable())
+        indice.compactador.join();
+}
+
+IndiceSegmentado::~IndiceSegmentado()
+{
+    detenerCompactacion(*this);
+}
+
+size_t numSegmentos(const IndiceSegmentado &indice)
+{
+    std::shared_lock<std::shared_mutex> lock(indice.mutex);
+    return indice.segmentos.size();
+}
+
+size_t numDocumentosVigentes(const IndiceSegmentado &indice)
+{
+    std::shared_lock<std::shared_mutex> lock(indice.mutex);
+    return indice.idPorNombre.size();
+}
+
+size_t numCompactaciones(const IndiceSegmentado &indice)
+{
+    std::shared_lock<std::shared_mutex> lock(indice.mutex);
+    return indice.compactaciones;
+}
@@ -0,0 +1,110 @@
+#ifndef INDICE_SEGMENTADO_H
+#define INDICE_SEGMENTADO_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+
+#include "suffix_array.h"
+
+// Segmento inmutable del indice: un lote de documentos concatenados con '$' y
+// su propio suffix array. Un segmento mide a lo sumo 1 GiB, asi sus arreglos
+// siempre caben en Offset32.
+struct SegmentoIndice
+{
+    std::string texto;
+    std::vector<Offset32> sa;
+    LCPBusqueda lcp;
+    std::vector<Offset32> cortes; // fin de cada documento dentro del segmento
+    std::vector<int> docIds;      // id global de cada documento (creciente)
+};
+
+// Coincidencia en el indice segmentado
+struct CoincidenciaSegmentada
+{
+    int doc;        // id global del documento (base 0)
+    int64_t offset; // posicion desde el inicio del documento
+};
+
+// Indice formado por varios segmentos: cada lote de documentos nuevos arma
+// un segmento chico en vez de reconstruir el suffix array de todo el corpus,
+// las consultas recorren todos los segmentos y mezclan los resultados, y la
+// compactacion fusiona segmentos chicos en uno mas grande. Los documentos
+// borrados quedan marcados con una lapida (por id) hasta que una compactacion
+// reescribe su segmento sin ellos.
+//
+// Se puede consultar desde varios hilos mientras otro agrega, borra o compacta:
+// las consultas toman el candado compartido y los cambios lo toman exclusivo
+// solo para publicar el resultado (los suffix arrays se construyen fuera).
+struct IndiceSegmentado
+{
+    std::vector<std::shared_ptr<const SegmentoIndice>> segmentos;
+    std::vector<std::string> nombres;                 // por id global
+    std::vector<char> borrado;                        // lapida por id global
+    std::unordered_map<std::string, int> idPorNombre; // documentos vigentes
+    std::unordered_map<std::string, uint64_t> huellas; // ultima huella vista (sincronizarCarpeta)
+    size_t compactaciones = 0;                        // fusiones realizadas
+
+    IndiceSegmentado() = default;
+    ~IndiceSegmentado();
+    IndiceSegmentado(const IndiceSegmentado &) = delete;
+    IndiceSegmentado &operator=(const IndiceSegmentado &) = delete;
+
+    // Estado interno
+    mutable std::shared_mutex mutex;
+    std::mutex mutexFusion; // una sola compactacion a la vez
+    std::thread compactador;
+    std::mutex mutexAviso;
+    std::condition_variable aviso;
+    bool hayCambios = false;
+    bool detener = false;
+};
+
+// Agrega un lote de documentos como un segmento nuevo (varios si el lote
+// supera el tamaño maximo de un segmento). Si un documento ya existia con el
+// mismo nombre, la version anterior queda borrada. Devuelve el id del primer
+// documento del lote, o -1 si algun documento no entra en un segmento.
+int agregarDocumentos(IndiceSegmentado &indice,
+                      const std::vector<std::string> &nombres,
+                      const std::vector<std::string> &contenidos);
+
+// Marca el documento como borrado (lapida). Devuelve false si no existe o ya
+// estaba borrado.
+bool eliminarDocumento(IndiceSegmentado &indice, int doc);
+bool eliminarDocumento(IndiceSegmentado &indice, const std::string &nombre);
+
+// Lleva el indice al estado de la carpeta: los .txt nuevos forman un lote, los
+// que ya no estan se borran y los modificados (otra huella) se borran y se
+// vuelven a agregar. Devuelve la cantidad de documentos agregados o borrados.
+size_t sincronizarCarpeta(IndiceSegmentado &indice, const std::string &carpeta, int hilos = 1);
+
+// Busca el patron en todos los segmentos (en hasta 'hilos' hilos) y devuelve
+// las coincidencias de los documentos vigentes, ordenadas por documento y offset
+std::vector<CoincidenciaSegmentada> buscarEnIndiceSegmentado(const IndiceSegmentado &indice,
+                                                             std::string_view patron, int hilos = 1);
+
+// Una ronda de compactacion por niveles: cuando hay FACTOR_FUSION segmentos
+// de un mismo nivel de tamaño se fusionan en uno, y un segmento con mas de la
+// mitad de sus documentos borrados se reescribe sin ellos. Devuelve false si
+// no habia nada que compactar.
+bool compactarSegmentos(IndiceSegmentado &indice);
+
+// Compactacion en segundo plano: un hilo que compacta cada vez que se agregan
+// o borran documentos, hasta que no queda nada para fusionar
+void iniciarCompactacion(IndiceSegmentado &indice);
+void detenerCompactacion(IndiceSegmentado &indice);
+
+// Cantidad de segmentos, de documentos vigentes y de compactaciones realizadas
+size_t numSegmentos(const IndiceSegmentado &indice);
+size_t numDocumentosVigentes(const IndiceSegmentado &indice);
+size_t numCompactaciones(const IndiceSegmentado &indice);
+
+#endif
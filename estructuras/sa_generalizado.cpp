@@ -0,0 +1,159 @@
+#include "sa_generalizado.h"
+#include "io.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+// Filas por bloque del RMQ: la tabla dispersa es sobre n / BLOQUE_RMQ bloques
+const size_t BLOQUE_RMQ = 32;
+
+// Fila con el minimo de 'anterior' en [l, r), recorriendo linealmente
+template <typename Offset>
+static Offset minimoLineal(const std::vector<Offset>& anterior, Offset l, Offset r) {
+    Offset mejor = l;
+    for (Offset i = l + 1; i < r; ++i) {
+        if (anterior[i] < anterior[mejor]) mejor = i;
+    }
+    return mejor;
+}
+
+template <typename Offset>
+static Offset menor(const std::vector<Offset>& anterior, Offset a, Offset b) {
+    return anterior[b] < anterior[a] ? b : a;
+}
+
+template <typename Offset>
+static void construirRMQ(SAGeneralizadoT<Offset>& g) {
+    size_t n = g.anterior.size();
+    size_t bloques = (n + BLOQUE_RMQ - 1) / BLOQUE_RMQ;
+    if (bloques == 0) return;
+
+    std::vector<Offset> base(bloques);
+    for (size_t b = 0; b < bloques; ++b) {
+        base[b] = minimoLineal(g.anterior, (Offset)(b * BLOQUE_RMQ), (Offset)std::min(n, (b + 1) * BLOQUE_RMQ));
+    }
+    g.rmq.push_back(std::move(base));
+    for (size_t ancho = 2; ancho <= bloques; ancho *= 2) {
+        const std::vector<Offset>& previo = g.rmq.back();
+        std::vector<Offset> nivel(bloques - ancho + 1);
+        for (size_t b = 0; b + ancho <= bloques; ++b) {
+            nivel[b] = menor(g.anterior, previo[b], previo[b + ancho / 2]);
+        }
+        g.rmq.push_back(std::move(nivel));
+    }
+}
+
+// Fila con el minimo de 'anterior' en [l, r) (r > l)
+template <typename Offset>
+static Offset minimoRMQ(const SAGeneralizadoT<Offset>& g, Offset l, Offset r) {
+    size_t bl = l / BLOQUE_RMQ, br = (r - 1) / BLOQUE_RMQ;
+    if (bl == br) return minimoLineal(g.anterior, l, r);
+
+    // Extremos parciales linealmente, bloques completos del medio con la tabla
+    Offset mejor = minimoLineal(g.anterior, l, (Offset)((bl + 1) * BLOQUE_RMQ));
+    mejor = menor(g.anterior, mejor, minimoLineal(g.anterior, (Offset)(br * BLOQUE_RMQ), r));
+    if (bl + 1 < br) {
+        size_t desde = bl + 1, cuantos = br - desde;
+        int k = 0;
+        while ((size_t(2) << k) <= cuantos) ++k;
+        mejor = menor(g.anterior, mejor, g.rmq[k][desde]);
+        mejor = menor(g.anterior, mejor, g.rmq[k][br - (size_t(1) << k)]);
+    }
+    return mejor;
+}
+
+template <typename Offset>
+SAGeneralizadoT<Offset> construirSAGeneralizado(std::string_view texto, const std::vector<int64_t>& cortes) {
+    verificarTamTexto<Offset>(texto.size());
+    SAGeneralizadoT<Offset> g;
+    if (cortes.empty()) return g;
+    // Cada sufijo tiene que caer en algun documento: el texto termina en el ultimo corte
+    assert(texto.size() == (size_t)cortes.back());
+    g.sa = construirSuffixArray<Offset>(texto);
+    g.lcp = construirLCPBusqueda(construirLCP(texto, g.sa));
+    g.numDocs = cortes.size();
+
+    size_t n = g.sa.size();
+    g.da.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        g.da[i] = obtenerDocumento(g.sa[i], cortes) - 1;
+    }
+
+    // Fila anterior del mismo documento y filas de cada documento (crecientes)
+    g.anterior.resize(n);
+    std::vector<Offset> ultima(g.numDocs, -1);
+    g.inicioFilas.assign(g.numDocs + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        g.anterior[i] = ultima[g.da[i]];
+        ultima[g.da[i]] = (Offset)i;
+        g.inicioFilas[g.da[i] + 1]++;
+    }
+    for (size_t d = 0; d < g.numDocs; ++d) g.inicioFilas[d + 1] += g.inicioFilas[d];
+    g.filasDoc.resize(n);
+    std::vector<Offset> siguiente(g.inicioFilas.begin(), g.inicioFilas.end() - 1);
+    for (size_t i = 0; i < n; ++i) g.filasDoc[siguiente[g.da[i]]++] = (Offset)i;
+
+    construirRMQ(g);
+    return g;
+}
+
+// Intervalo [sp, ep) del SA con los sufijos que empiezan con el patron
+template <typename Offset>
+static bool intervaloPatron(const SAGeneralizadoT<Offset>& g, std::string_view texto, std::string_view patron,
+                            Offset& sp, Offset& ep) {
+    if (patron.empty() || g.sa.empty()) return false;
+    intervaloSuffixArray(texto, patron, g.sa.data(), g.lcp.izq.data(), g.lcp.der.data(), sp, ep);
+    return sp < ep;
+}
+
+// Documentos distintos de las filas [sp, ep), ordenados
+template <typename Offset>
+static std::vector<int> documentosEnIntervalo(const SAGeneralizadoT<Offset>& g, Offset sp, Offset ep) {
+    std::vector<int> docs;
+
+    // Muthukrishnan: la fila k con el minimo 'anterior' en [l, r) es la
+    // primera de su documento dentro de [sp, ep) si anterior[k] < sp; si no,
+    // todos los documentos de [l, r) ya se reportaron
+    std::vector<std::pair<Offset, Offset>> pendientes = {{sp, ep}};
+    while (!pendientes.empty()) {
+        auto [l, r] = pendientes.back();
+        pendientes.pop_back();
+        Offset k = minimoRMQ(g, l, r);
+        if (g.anterior[k] >= sp) continue;
+        docs.push_back(g.da[k]);
+        if (l < k) pendientes.push_back({l, k});
+        if (k + 1 < r) pendientes.push_back({k + 1, r});
+    }
+    std::sort(docs.begin(), docs.end());
+    return docs;
+}
+
+template <typename Offset>
+std::vector<int> documentosConPatron(const SAGeneralizadoT<Offset>& g, std::string_view texto, std::string_view patron) {
+    Offset sp, ep;
+    if (!intervaloPatron(g, texto, patron, sp, ep)) return {};
+    return documentosEnIntervalo(g, sp, ep);
+}
+
+template <typename Offset>
+std::vector<ConteoDocumento> conteoPorDocumento(const SAGeneralizadoT<Offset>& g, std::string_view texto,
+                                                std::string_view patron) {
+    std::vector<ConteoDocumento> conteos;
+    Offset sp, ep;
+    if (!intervaloPatron(g, texto, patron, sp, ep)) return conteos;
+
+    for (int d : documentosEnIntervalo(g, sp, ep)) {
+        const Offset* inicio = g.filasDoc.data() + g.inicioFilas[d];
+        const Offset* fin = g.filasDoc.data() + g.inicioFilas[d + 1];
+        size_t cuenta = std::lower_bound(inicio, fin, ep) - std::lower_bound(inicio, fin, sp);
+        conteos.push_back({d, cuenta});
+    }
+    return conteos;
+}
+
+template SAGeneralizadoT<Offset32> construirSAGeneralizado<Offset32>(std::string_view, const std::vector<int64_t>&);
+template SAGeneralizadoT<Offset64> construirSAGeneralizado<Offset64>(std::string_view, const std::vector<int64_t>&);
+template std::vector<int> documentosConPatron<Offset32>(const SAGeneralizadoT<Offset32>&, std::string_view, std::string_view);
+template std::vector<int> documentosConPatron<Offset64>(const SAGeneralizadoT<Offset64>&, std::string_view, std::string_view);
+template std::vector<ConteoDocumento> conteoPorDocumento<Offset32>(const SAGeneralizadoT<Offset32>&, std::string_view, std::string_view);
+template std::vector<ConteoDocumento> conteoPorDocumento<Offset64>(const SAGeneralizadoT<Offset64>&, std::string_view, std::string_view);
@@ -0,0 +1,58 @@
+#ifndef SA_GENERALIZADO_H
+#define SA_GENERALIZADO_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include "suffix_array.h"
+
+// Suffix array generalizado sobre el corpus concatenado con '$': ademas del
+// SA guarda, alineado con el, el documento de cada sufijo. Responde "que
+// documentos contienen el patron" con el algoritmo de Muthukrishnan (RMQ
+// sobre la fila anterior del mismo documento) en tiempo proporcional a la
+// cantidad de documentos distintos, no a la de ocurrencias.
+template <typename Offset>
+struct SAGeneralizadoT {
+    std::vector<Offset> sa;
+    LCPBusquedaT<Offset> lcp;
+    std::vector<int> da;          // documento (base 0) del sufijo sa[i]
+    std::vector<Offset> anterior; // fila previa con el mismo documento (-1 si no hay)
+
+    // RMQ por bloques sobre 'anterior': rmq[k][b] es la fila con el minimo de
+    // los bloques [b, b + 2^k); dentro de un bloque se recorre linealmente
+    std::vector<std::vector<Offset>> rmq;
+
+    // Filas de cada documento, crecientes: filasDoc[inicioFilas[d] .. inicioFilas[d + 1])
+    std::vector<Offset> inicioFilas;
+    std::vector<Offset> filasDoc;
+    size_t numDocs = 0;
+};
+using SAGeneralizado = SAGeneralizadoT<Offset32>;
+using SAGeneralizado64 = SAGeneralizadoT<Offset64>;
+
+// Cantidad de ocurrencias del patron en un documento
+struct ConteoDocumento {
+    int doc; // base 0
+    size_t cuenta;
+};
+
+// Construye SA, LCP, arreglo de documentos y RMQ. 'cortes' son los del
+// Corpus: posicion donde termina cada documento (despues de su '$'); el texto
+// tiene que terminar en el ultimo corte. Sin cortes devuelve la estructura vacia.
+template <typename Offset = Offset32>
+SAGeneralizadoT<Offset> construirSAGeneralizado(std::string_view texto, const std::vector<int64_t>& cortes);
+
+// Documentos distintos que contienen el patron (ordenados), sin recorrer
+// cada ocurrencia: O(m + log n + d) consultas RMQ para d documentos
+template <typename Offset>
+std::vector<int> documentosConPatron(const SAGeneralizadoT<Offset>& g, std::string_view texto, std::string_view patron);
+
+// Igual, con la cantidad de ocurrencias en cada documento (busqueda binaria
+// en las filas del documento: O(log n) por documento)
+template <typename Offset>
+std::vector<ConteoDocumento> conteoPorDocumento(const SAGeneralizadoT<Offset>& g, std::string_view texto,
+                                                std::string_view patron);
+
+#endif
@@ -0,0 +1,150 @@
+#include "similitud.h"
+#include "rabin_karp.h"
+#include "paralelo.h"
+#include "resultados.h"
+#include <algorithm>
+#include <deque>
+
+// Deja solo letras y digitos (los bytes >= 0x80 se conservan: tildes en UTF-8)
+// con el ASCII en minusculas, asi espacios, puntuacion y mayusculas no cambian las huellas
+static std::string normalizarTexto(std::string_view documento) {
+    std::string salida;
+    salida.reserve(documento.size());
+    for (unsigned char c : documento) {
+        if (c >= 'A' && c <= 'Z') salida.push_back(c - 'A' + 'a');
+        else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c >= 0x80) salida.push_back(c);
+    }
+    return salida;
+}
+
+std::vector<uint64_t> huellasWinnowing(std::string_view documento, const ParametrosWinnowing &parametros) {
+    std::string normalizado;
+    if (parametros.normalizar) {
+        normalizado = normalizarTexto(documento);
+        documento = normalizado;
+    }
+
+    std::vector<uint64_t> huellas;
+    int k = std::max(1, parametros.k);
+    size_t w = std::max(1, parametros.ventana);
+    if (documento.size() < (size_t)k) return huellas;
+
+    // Hash rodante de cada k-grama y minimo de cada ventana con una cola
+    // monotona: en el frente queda el minimo (el de mas a la derecha si hay
+    // empate) y solo se agrega una huella cuando cambia su posicion
+    size_t gramas = documento.size() - k + 1;
+    uint64_t potencia = potenciaRabinKarp(k);
+    uint64_t hash = hashRabinKarp(documento.substr(0, k));
+    std::vector<uint64_t> hashes(gramas);
+    for (size_t i = 0; i < gramas; ++i) {
+        hashes[i] = hash;
+        if (i + 1 < gramas)
+            hash = rodarHashRabinKarp(hash, documento[i], documento[i + k], potencia);
+    }
+
+    std::deque<size_t> cola;
+    size_t elegido = SIZE_MAX;
+    for (size_t i = 0; i < gramas; ++i) {
+        while (!cola.empty() && hashes[cola.back()] >= hashes[i]) cola.pop_back();
+        cola.push_back(i);
+        if (cola.front() + w <= i) cola.pop_front();
+        // Primera ventana completa (o la unica, si hay menos de w k-gramas)
+        if (i + 1 >= w || i + 1 == gramas) {
+            if (cola.front() != elegido) {
+                elegido = cola.front();
+                huellas.push_back(hashes[elegido]);
+            }
+        }
+    }
+
+    std::sort(huellas.begin(), huellas.end());
+    huellas.erase(std::unique(huellas.begin(), huellas.end()), huellas.end());
+    return huellas;
+}
+
+template <typename Offset>
+IndiceHuellas construirIndiceHuellas(std::string_view texto, const std::vector<Offset> &cortes,
+                                     const ParametrosWinnowing &parametros, int hilos) {
+    IndiceHuellas indice;
+    indice.parametros = parametros;
+    size_t numDocs = cortes.size();
+    indice.huellas.resize(numDocs);
+
+    // Documentos de tamaño muy distinto: reparto con robo de trabajo
+    paraleloRobo(numDocs, hilos, [&](size_t d) {
+        size_t desde = d == 0 ? 0 : (size_t)cortes[d - 1];
+        size_t hasta = (size_t)cortes[d] - 1; // sin el '$'
+        indice.huellas[d] = huellasWinnowing(texto.substr(desde, hasta - desde), parametros);
+    });
+
+    // Indice invertido: pares (huella, documento) ordenados y agrupados por huella
+    std::vector<std::pair<uint64_t, int>> pares;
+    for (size_t d = 0; d < numDocs; ++d) {
+        for (uint64_t h : indice.huellas[d]) pares.push_back({h, (int)d});
+    }
+    std::sort(pares.begin(), pares.end());
+    indice.docs.reserve(pares.size());
+    for (size_t i = 0; i < pares.size(); ++i) {
+        if (i == 0 || pares[i].first != pares[i - 1].first) {
+            indice.claves.push_back(pares[i].first);
+            indice.inicio.push_back(i);
+        }
+        indice.docs.push_back(pares[i].second);
+    }
+    indice.inicio.push_back(pares.size());
+    return indice;
+}
+
+std::vector<ParSimilar> paresSimilares(const IndiceHuellas &indice, double umbral, size_t limite,
+                                       size_t maxDocsPorHuella, int hilos) {
+    // Cada huella compartida aporta una clave (a << 32 | b) por par de sus
+    // documentos; las claves se generan por trozos de huellas en paralelo
+    size_t numClaves = indice.claves.size();
+    size_t trozos = std::min<size_t>(std::max(1, hilos) * 4, std::max<size_t>(1, numClaves));
+    std::vector<std::vector<uint64_t>> porTrozo(trozos);
+    paraleloPara(trozos, hilos, [&](size_t t) {
+        for (size_t c = numClaves * t / trozos; c < numClaves * (t + 1) / trozos; ++c) {
+            size_t desde = indice.inicio[c], hasta = indice.inicio[c + 1];
+            if (hasta - desde < 2 || (maxDocsPorHuella > 0 && hasta - desde > maxDocsPorHuella)) continue;
+            for (size_t i = desde; i < hasta; ++i) {
+                for (size_t j = i + 1; j < hasta; ++j)
+                    porTrozo[t].push_back((uint64_t)indice.docs[i] << 32 | (uint32_t)indice.docs[j]);
+            }
+        }
+        std::sort(porTrozo[t].begin(), porTrozo[t].end());
+    });
+
+    std::vector<uint64_t> claves;
+    for (auto &lista : porTrozo) {
+        claves.insert(claves.end(), lista.begin(), lista.end());
+        std::vector<uint64_t>().swap(lista);
+    }
+    std::sort(claves.begin(), claves.end());
+
+    // Cantidad de huellas comunes de cada par = largo de su racha de claves iguales
+    std::vector<ParSimilar> pares;
+    for (size_t i = 0; i < claves.size();) {
+        size_t j = i;
+        while (j < claves.size() && claves[j] == claves[i]) ++j;
+        int a = claves[i] >> 32, b = (uint32_t)claves[i];
+        size_t comunes = j - i;
+        size_t tamA = indice.huellas[a].size(), tamB = indice.huellas[b].size();
+        double jaccard = (double)comunes / (tamA + tamB - comunes);
+        if (jaccard >= umbral)
+            pares.push_back({a, b, comunes, jaccard, (double)comunes / std::min(tamA, tamB)});
+        i = j;
+    }
+
+    std::sort(pares.begin(), pares.end(), [](const ParSimilar &x, const ParSimilar &y) {
+        if (x.jaccard != y.jaccard) return x.jaccard > y.jaccard;
+        if (x.comunes != y.comunes) return x.comunes > y.comunes;
+        return std::make_pair(x.a, x.b) < std::make_pair(y.a, y.b);
+    });
+    if (limite > 0 && pares.size() > limite) pares.resize(limite);
+    return pares;
+}
+
+template IndiceHuellas construirIndiceHuellas<Offset32>(std::string_view, const std::vector<Offset32> &,
+                                                        const ParametrosWinnowing &, int);
+template IndiceHuellas construirIndiceHuellas<Offset64>(std::string_view, const std::vector<Offset64> &,
+                                                        const ParametrosWinnowing &, int);
@@ -0,0 +1,61 @@
+#ifndef SIMILITUD_H
+#define SIMILITUD_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+// Parametros del winnowing: se hashea cada k-grama del documento normalizado
+// y de cada ventana de 'ventana' hashes consecutivos se elige el minimo. Toda
+// coincidencia de al menos k + ventana - 1 bytes (ya normalizados) comparte
+// una huella; las de menos de k bytes nunca.
+struct ParametrosWinnowing {
+    int k = 25;
+    int ventana = 40;
+    bool normalizar = true; // solo letras y digitos, ASCII en minusculas
+};
+
+// Huellas del corpus e indice invertido huella -> documentos
+struct IndiceHuellas {
+    ParametrosWinnowing parametros;
+    std::vector<std::vector<uint64_t>> huellas; // por documento, ordenadas y sin repetir
+
+    // Indice invertido: claves ordenadas; los documentos de claves[i] (crecientes)
+    // son docs[inicio[i] .. inicio[i + 1])
+    std::vector<uint64_t> claves;
+    std::vector<size_t> inicio;
+    std::vector<int> docs;
+};
+
+// Par de documentos (base 0, a < b) con huellas en comun
+struct ParSimilar {
+    int a, b;
+    size_t comunes;
+    double jaccard;    // comunes / |A u B|
+    double contencion; // comunes / min(|A|, |B|): alto si uno esta copiado dentro del otro
+};
+
+// Huellas (ordenadas, sin repetir) de un documento
+std::vector<uint64_t> huellasWinnowing(std::string_view documento, const ParametrosWinnowing &parametros);
+
+// Huellas de cada documento del texto concatenado con '$' (la salida de
+// leerDocumentosDesdeCarpeta: 'cortes' es donde termina cada documento, tras
+// su '$'), repartidas por documento en 'hilos' hilos, y el indice invertido
+template <typename Offset>
+IndiceHuellas construirIndiceHuellas(std::string_view texto, const std::vector<Offset> &cortes,
+                                     const ParametrosWinnowing &parametros = ParametrosWinnowing(), int hilos = 1);
+
+// Pares de documentos con huellas en comun, de mayor a menor Jaccard. Cada
+// huella aporta los pares de su lista de documentos, sin comparar todos contra
+// todos; las huellas presentes en mas de 'maxDocsPorHuella' documentos (texto
+// repetido en todo el corpus) se ignoran para que el costo no sea cuadratico
+// (0 = sin limite). Una huella ignorada no suma a 'comunes' pero sigue contando
+// en |A| y |B|: el Jaccard de esos pares queda subestimado, y un texto copiado
+// en mas de 'maxDocsPorHuella' documentos no los relaciona.
+// Se descartan los pares bajo 'umbral' de Jaccard; 'limite' > 0 corta la lista.
+std::vector<ParSimilar> paresSimilares(const IndiceHuellas &indice, double umbral = 0.0, size_t limite = 0,
+                                       size_t maxDocsPorHuella = 64, int hilos = 1);
+
+#endif
@@ -1,31 +1,36 @@
 //Solucion estructurada
 
 #include "suffix_array.h"
+#include "paralelo.h"
 #include <algorithm>
 #include <iostream>
+#include <utility>
 
-// Construye el suffix array
-std::vector<int> construirSuffixArray(const std::string& texto) {
-    int n = texto.size();
-    std::vector<int> sa(n), rank(n), tmp(n);
+// Construye el suffix array por duplicacion de prefijos (O(n log^2 n)).
+// Se mantiene para comparar contra SA-IS.
+template <typename Offset>
+static std::vector<Offset> construirPorDuplicacion(std::string_view texto) {
+    Offset n = texto.size();
+    std::vector<Offset> sa(n), rank(n), tmp(n);
 
     // Paso 1: Suffixes iniciales por posición
-    for (int i = 0; i < n; ++i) {
+    // (bytes sin signo, mismo orden que la comparacion de std::string)
+    for (Offset i = 0; i < n; ++i) {
         sa[i] = i;
-        rank[i] = texto[i];
+        rank[i] = (unsigned char)texto[i];
     }
 
-    for (int k = 1; k < n; k *= 2) {
-        auto cmp = [&](int i, int j) {
+    for (Offset k = 1; k < n; k *= 2) {
+        auto cmp = [&](Offset i, Offset j) {
             if (rank[i] != rank[j]) return rank[i] < rank[j];
-            int ri = (i + k < n) ? rank[i + k] : -1;
-            int rj = (j + k < n) ? rank[j + k] : -1;
+            Offset ri = (i + k < n) ? rank[i + k] : -1;
+            Offset rj = (j + k < n) ? rank[j + k] : -1;
             return ri < rj;
         };
         std::sort(sa.begin(), sa.end(), cmp);
 
         tmp[sa[0]] = 0;
-        for (int i = 1; i < n; ++i) {
+        for (Offset i = 1; i < n; ++i) {
             tmp[sa[i]] = tmp[sa[i - 1]] + cmp(sa[i - 1], sa[i]);
         }
         rank = tmp;
@@ -34,34 +39,457 @@ std::vector<int> construirSuffixArray(const std::string& texto) {
     return sa;
 }
 
-// Se hace búsqueda binaria del patrón en el texto usando el suffix array
-std::vector<int> buscarConSuffixArray(const std::string& texto,
-                                      const std::string& patron,
-                                      const std::vector<int>& sa) {
-    std::vector<int> ocurrencias;
-    int n = texto.size();
-    int m = patron.size();
-
-    int l = 0, r = n - 1;
-    // Buscar la primera posición donde puede aparecer el patrón
-    while (l <= r) {
-        int mid = (l + r) / 2;
-        std::string sufijo = texto.substr(sa[mid], std::min(m, n - sa[mid]));
-        if (sufijo < patron)
-            l = mid + 1;
-        else
-            r = mid - 1;
-    }
-
-    // Desde "l" buscamos todas las ocurrencias
-    while (l < n) {
-        std::string sufijo = texto.substr(sa[l], std::min(m, n - sa[l]));
-        if (sufijo.substr(0, m) == patron)
-            ocurrencias.push_back(sa[l]);
-        else
-            break;
-        ++l;
-    }
-
-    return ocurrencias;
-}
\ No newline at end of file
+// ---------------------------------------------------------------------------
+// Duplicacion de prefijos paralela (Larsson-Sadakane). Tras la ronda de largo
+// h, sa esta ordenado por los primeros h caracteres y rank[i] es la primera
+// fila del grupo de sufijos que comparten esos h caracteres con i. La ronda
+// siguiente solo reordena los grupos de mas de un sufijo, por rank[i + h], y
+// los grupos son independientes entre si: se reparten en tareas de tamaño
+// parecido y los grupos grandes se ordenan por trozos y se mezclan en paralelo.
+// Memoria temporal: rank y un par (clave, posicion) por fila, 3n offsets.
+// ---------------------------------------------------------------------------
+
+// Ordena v[desde, hasta) por clave: trozos con std::sort y mezclas por pares
+template <typename Offset>
+static void ordenarParalelo(std::vector<std::pair<Offset, Offset>>& v, size_t desde, size_t hasta, int hilos) {
+    auto menorClave = [](const std::pair<Offset, Offset>& a, const std::pair<Offset, Offset>& b) {
+        return a.first < b.first;
+    };
+    size_t partes = std::max(1, hilos);
+    std::vector<size_t> limite(partes + 1);
+    for (size_t k = 0; k <= partes; ++k) limite[k] = desde + (hasta - desde) * k / partes;
+
+    paraleloPara(partes, hilos, [&](size_t k) {
+        std::sort(v.begin() + limite[k], v.begin() + limite[k + 1], menorClave);
+    });
+    for (size_t ancho = 1; ancho < partes; ancho *= 2) {
+        size_t pares = (partes + 2 * ancho - 1) / (2 * ancho);
+        paraleloPara(pares, hilos, [&](size_t p) {
+            size_t a = 2 * ancho * p, b = std::min(a + ancho, partes), c = std::min(a + 2 * ancho, partes);
+            if (b < c) std::inplace_merge(v.begin() + limite[a], v.begin() + limite[b], v.begin() + limite[c], menorClave);
+        });
+    }
+}
+
+// Rango [inicio, fin) de filas de un grupo sin ordenar
+template <typename Offset>
+using GrupoSA = std::pair<Offset, Offset>;
+
+template <typename Offset>
+static std::vector<Offset> construirPorDuplicacionParalela(std::string_view texto, int hilos) {
+    size_t n = texto.size();
+    std::vector<Offset> sa(n), rank(n);
+    if (n == 0) return sa;
+    hilos = std::max(1, hilos);
+    const unsigned char* t = reinterpret_cast<const unsigned char*>(texto.data());
+
+    // Ronda inicial: conteo por los dos primeros bytes (0 = fin del texto),
+    // con un histograma por trozo para repartir sin sincronizar
+    const size_t CUBETAS = 256 * 257;
+    auto cubeta = [&](size_t i) { return t[i] * 257 + (i + 1 < n ? t[i + 1] + 1 : 0); };
+    size_t trozos = std::min<size_t>(hilos, (n + 65535) / 65536);
+    std::vector<std::vector<Offset>> conteo(trozos, std::vector<Offset>(CUBETAS, 0));
+    paraleloPara(trozos, hilos, [&](size_t k) {
+        for (size_t i = n * k / trozos; i < n * (k + 1) / trozos; ++i) conteo[k][cubeta(i)]++;
+    });
+    std::vector<Offset> inicioCubeta(CUBETAS + 1, 0);
+    Offset suma = 0;
+    for (size_t c = 0; c < CUBETAS; ++c) {
+        inicioCubeta[c] = suma;
+        for (size_t k = 0; k < trozos; ++k) {
+            Offset cuantos = conteo[k][c];
+            conteo[k][c] = suma;
+            suma += cuantos;
+        }
+    }
+    inicioCubeta[CUBETAS] = suma;
+    paraleloPara(trozos, hilos, [&](size_t k) {
+        for (size_t i = n * k / trozos; i < n * (k + 1) / trozos; ++i) {
+            size_t c = cubeta(i);
+            sa[conteo[k][c]++] = (Offset)i;
+            rank[i] = inicioCubeta[c];
+        }
+    });
+    std::vector<std::vector<Offset>>().swap(conteo);
+
+    std::vector<GrupoSA<Offset>> grupos;
+    for (size_t c = 0; c < CUBETAS; ++c) {
+        if (inicioCubeta[c + 1] - inicioCubeta[c] > 1) grupos.push_back({inicioCubeta[c], inicioCubeta[c + 1]});
+    }
+
+    std::vector<std::pair<Offset, Offset>> par(n);
+    const size_t tamTarea = std::max<size_t>(n / ((size_t)hilos * 8), 1 << 14);
+    for (size_t h = 2; !grupos.empty() && h < n; h *= 2) {
+        // Tareas: grupos pequeños consecutivos hasta ~tamTarea filas; los
+        // grupos mas grandes se tratan aparte con todos los hilos
+        std::vector<std::pair<size_t, size_t>> tareas;
+        std::vector<size_t> grandes;
+        for (size_t g = 0; g < grupos.size();) {
+            if ((size_t)(grupos[g].second - grupos[g].first) > tamTarea) {
+                grandes.push_back(g++);
+                continue;
+            }
+            size_t desde = g, filas = 0;
+            while (g < grupos.size() && filas < tamTarea &&
+                   (size_t)(grupos[g].second - grupos[g].first) <= tamTarea) {
+                filas += grupos[g].second - grupos[g].first;
+                ++g;
+            }
+            tareas.push_back({desde, g});
+        }
+
+        // Las claves se leen todas antes de tocar rank (otros grupos lo leen en esta ronda)
+        auto clave = [&](Offset i) { return (size_t)i + h < n ? rank[i + h] : (Offset)-1; };
+        auto leerClaves = [&](size_t desde, size_t hasta) {
+            for (size_t j = desde; j < hasta; ++j) par[j] = {clave(sa[j]), sa[j]};
+        };
+        paraleloPara(tareas.size(), hilos, [&](size_t k) {
+            for (size_t g = tareas[k].first; g < tareas[k].second; ++g) leerClaves(grupos[g].first, grupos[g].second);
+        });
+        for (size_t g : grandes) {
+            size_t desde = grupos[g].first, largo = grupos[g].second - desde;
+            paraleloPara(hilos, hilos, [&](size_t k) {
+                leerClaves(desde + largo * k / hilos, desde + largo * (k + 1) / hilos);
+            });
+        }
+
+        // Ordenar cada grupo por clave, escribir sa y los nuevos rangos;
+        // los subgrupos de mas de un sufijo pasan a la ronda siguiente
+        auto ordenarGrupo = [&](const GrupoSA<Offset>& grupo, std::vector<GrupoSA<Offset>>& nuevos, bool ordenado) {
+            Offset desde = grupo.first, hasta = grupo.second;
+            if (!ordenado) {
+                std::sort(par.begin() + desde, par.begin() + hasta,
+                          [](const std::pair<Offset, Offset>& a, const std::pair<Offset, Offset>& b) {
+                              return a.first < b.first;
+                          });
+            }
+            Offset inicio = desde;
+            for (Offset j = desde; j < hasta; ++j) {
+                if (par[j].first != par[inicio].first) {
+                    if (j - inicio > 1) nuevos.push_back({inicio, j});
+                    inicio = j;
+                }
+                sa[j] = par[j].second;
+                rank[par[j].second] = inicio;
+            }
+            if (hasta - inicio > 1) nuevos.push_back({inicio, hasta});
+        };
+        std::vector<std::vector<GrupoSA<Offset>>> nuevos(tareas.size() + grandes.size());
+        paraleloPara(tareas.size(), hilos, [&](size_t k) {
+            for (size_t g = tareas[k].first; g < tareas[k].second; ++g) ordenarGrupo(grupos[g], nuevos[k], false);
+        });
+        for (size_t k = 0; k < grandes.size(); ++k) {
+            const GrupoSA<Offset>& grupo = grupos[grandes[k]];
+            ordenarParalelo(par, grupo.first, grupo.second, hilos);
+            ordenarGrupo(grupo, nuevos[tareas.size() + k], true);
+        }
+
+        grupos.clear();
+        for (auto& lista : nuevos) grupos.insert(grupos.end(), lista.begin(), lista.end());
+    }
+    return sa;
+}
+
+// ---------------------------------------------------------------------------
+// SA-IS (Nong, Zhang y Chan): ordenamiento inducido en tiempo lineal.
+// Se trabaja con un centinela virtual al final del texto (menor que cualquier
+// caracter), asi no hace falta copiar el texto para agregarlo. Memoria
+// temporal: 1 bit de tipo por posicion, los buckets del alfabeto y la
+// recursion, que reutiliza el propio arreglo 'sa' para el texto reducido.
+// ---------------------------------------------------------------------------
+
+// Calcula el inicio (o el fin) de cada bucket a partir de los conteos
+template <typename Offset>
+static void calcularBuckets(const std::vector<Offset>& conteo, std::vector<Offset>& bkt, bool fin) {
+    Offset suma = 0;
+    for (size_t c = 0; c < conteo.size(); ++c) {
+        suma += conteo[c];
+        bkt[c] = fin ? suma : suma - conteo[c];
+    }
+}
+
+// Induce los sufijos tipo L y luego los tipo S a partir de los LMS ya ubicados
+template <typename T, typename Offset>
+static void inducir(const T* s, Offset* sa, Offset n, const std::vector<bool>& tipoS,
+                    const std::vector<Offset>& conteo, std::vector<Offset>& bkt) {
+    calcularBuckets(conteo, bkt, false);
+    // El sufijo n-1 sigue al centinela virtual, que es el primero del orden
+    sa[bkt[s[n - 1]]++] = n - 1;
+    for (Offset i = 0; i < n; ++i) {
+        Offset j = sa[i] - 1;
+        if (sa[i] > 0 && !tipoS[j]) sa[bkt[s[j]]++] = j;
+    }
+    calcularBuckets(conteo, bkt, true);
+    for (Offset i = n - 1; i >= 0; --i) {
+        Offset j = sa[i] - 1;
+        if (sa[i] > 0 && tipoS[j]) sa[--bkt[s[j]]] = j;
+    }
+}
+
+// Ordena los sufijos de s[0..n), con simbolos en [0, K)
+template <typename T, typename Offset>
+static void sais(const T* s, Offset* sa, Offset n, Offset K) {
+    if (n == 0) return;
+    if (n == 1) { sa[0] = 0; return; }
+
+    // Clasificar cada posicion en tipo S (true) o L (false)
+    std::vector<bool> tipoS(n, false);
+    for (Offset i = n - 2; i >= 0; --i)
+        tipoS[i] = s[i] < s[i + 1] || (s[i] == s[i + 1] && tipoS[i + 1]);
+    auto esLMS = [&](Offset i) { return i > 0 && tipoS[i] && !tipoS[i - 1]; };
+
+    std::vector<Offset> conteo(K, 0), bkt(K);
+    for (Offset i = 0; i < n; ++i) conteo[s[i]]++;
+
+    // Paso 1: ordenar las subcadenas LMS con una primera induccion
+    for (Offset i = 0; i < n; ++i) sa[i] = -1;
+    calcularBuckets(conteo, bkt, true);
+    for (Offset i = 1; i < n; ++i)
+        if (esLMS(i)) sa[--bkt[s[i]]] = i;
+    inducir(s, sa, n, tipoS, conteo, bkt);
+
+    // Compactar las LMS ordenadas al inicio de sa
+    Offset n1 = 0;
+    for (Offset i = 0; i < n; ++i)
+        if (esLMS(sa[i])) sa[n1++] = sa[i];
+
+    // Paso 2: nombrar las subcadenas LMS; el nombre de la posicion p se guarda
+    // en sa[n1 + p / 2] (dos LMS nunca estan a distancia menor que 2)
+    for (Offset i = n1; i < n; ++i) sa[i] = -1;
+    Offset nombres = 0, previo = -1;
+    for (Offset i = 0; i < n1; ++i) {
+        Offset p = sa[i];
+        bool distinta = true;
+        if (previo >= 0) {
+            for (Offset d = 0;; ++d) {
+                if (p + d == n || previo + d == n) break;
+                if (s[p + d] != s[previo + d] || tipoS[p + d] != tipoS[previo + d]) break;
+                if (d > 0 && (esLMS(p + d) || esLMS(previo + d))) {
+                    distinta = !(esLMS(p + d) && esLMS(previo + d));
+                    break;
+                }
+            }
+        }
+        if (distinta) ++nombres;
+        previo = p;
+        sa[n1 + p / 2] = nombres - 1;
+    }
+
+    // Texto reducido (en orden de texto) al final de sa
+    for (Offset i = n - 1, j = n - 1; i >= n1; --i)
+        if (sa[i] >= 0) sa[j--] = sa[i];
+
+    // Paso 3: ordenar los sufijos LMS (recursion si hay nombres repetidos)
+    Offset* s1 = sa + n - n1;
+    if (nombres < n1) {
+        sais(s1, sa, n1, nombres);
+    } else {
+        for (Offset i = 0; i < n1; ++i) sa[s1[i]] = i;
+    }
+
+    // Reemplazar los indices del texto reducido por posiciones reales
+    for (Offset i = 1, j = 0; i < n; ++i)
+        if (esLMS(i)) s1[j++] = i;
+    for (Offset i = 0; i < n1; ++i) sa[i] = s1[sa[i]];
+
+    // Paso 4: ubicar las LMS ordenadas al final de sus buckets e inducir el resto
+    for (Offset i = n1; i < n; ++i) sa[i] = -1;
+    calcularBuckets(conteo, bkt, true);
+    for (Offset i = n1 - 1; i >= 0; --i) {
+        Offset j = sa[i];
+        sa[i] = -1;
+        sa[--bkt[s[j]]] = j;
+    }
+    inducir(s, sa, n, tipoS, conteo, bkt);
+}
+
+// Construye el suffix array
+template <typename Offset>
+std::vector<Offset> construirSuffixArray(std::string_view texto, MetodoSA metodo, int hilos) {
+    verificarTamTexto<Offset>(texto.size());
+    if (metodo == MetodoSA::Duplicacion)
+        return construirPorDuplicacion<Offset>(texto);
+    if (metodo == MetodoSA::DuplicacionParalela)
+        return construirPorDuplicacionParalela<Offset>(texto, hilos);
+
+    Offset n = texto.size();
+    std::vector<Offset> sa(n);
+    sais(reinterpret_cast<const unsigned char*>(texto.data()), sa.data(), n, (Offset)256);
+    return sa;
+}
+
+// Arreglo LCP con el algoritmo de Kasai en O(n)
+template <typename Offset>
+std::vector<Offset> construirLCP(std::string_view texto, const std::vector<Offset>& sa) {
+    verificarTamTexto<Offset>(texto.size());
+    Offset n = texto.size();
+    std::vector<Offset> lcp(n, 0), rank(n);
+    for (Offset i = 0; i < n; ++i) rank[sa[i]] = i;
+
+    Offset h = 0;
+    for (Offset i = 0; i < n; ++i) {
+        if (rank[i] == 0) { h = 0; continue; }
+        Offset j = sa[rank[i] - 1];
+        while (i + h < n && j + h < n && texto[i + h] == texto[j + h]) ++h;
+        lcp[rank[i]] = h;
+        if (h > 0) --h;
+    }
+    return lcp;
+}
+
+// Recorre el arbol implicito de la busqueda binaria sobre (l, r) y devuelve
+// el LCP entre sa[l] y sa[r] (0 si alguno de los extremos es virtual)
+template <typename Offset>
+static Offset llenarLCPBusqueda(const std::vector<Offset>& lcp, Offset l, Offset r, LCPBusquedaT<Offset>& b) {
+    Offset n = lcp.size();
+    if (r - l == 1) return (l >= 0 && r < n) ? lcp[r] : 0;
+    Offset mid = l + (r - l) / 2;
+    Offset a = llenarLCPBusqueda(lcp, l, mid, b);
+    Offset c = llenarLCPBusqueda(lcp, mid, r, b);
+    b.izq[mid] = a;
+    b.der[mid] = c;
+    return std::min(a, c);
+}
+
+template <typename Offset>
+LCPBusquedaT<Offset> construirLCPBusqueda(const std::vector<Offset>& lcp) {
+    LCPBusquedaT<Offset> b;
+    b.izq.assign(lcp.size(), 0);
+    b.der.assign(lcp.size(), 0);
+    llenarLCPBusqueda(lcp, (Offset)-1, (Offset)lcp.size(), b);
+    return b;
+}
+
+// Busqueda binaria de un limite del rango de ocurrencias, comparando en el
+// propio texto (sin copias). Devuelve el primer indice de sa cuyo sufijo,
+// truncado a m caracteres, es >= patron (superior = false) o > patron
+// (superior = true). Si se entregan izq/der se aplica Manber-Myers: nunca se
+// vuelve a comparar un caracter ya igualado, asi el costo es O(m + log n).
+// Sin ellos se parte de min(lcp con l, lcp con r).
+template <typename Offset>
+static Offset limiteRango(const char* t, Offset n, const char* p, Offset m, const Offset* sa,
+                          const Offset* izq, const Offset* der, bool superior) {
+    Offset l = -1, r = n;  // extremos virtuales: sa[-1] < patron < sa[n]
+    Offset lp = 0, rp = 0; // prefijo comun del patron con sa[l] y con sa[r]
+
+    while (r - l > 1) {
+        Offset mid = l + (r - l) / 2;
+        Offset k;
+        if (izq) {
+            if (lp >= rp) {
+                if (izq[mid] > lp) { l = mid; continue; }
+                if (izq[mid] < lp) { r = mid; rp = izq[mid]; continue; }
+                k = lp;
+            } else {
+                if (der[mid] > rp) { r = mid; continue; }
+                if (der[mid] < rp) { l = mid; lp = der[mid]; continue; }
+                k = rp;
+            }
+        } else {
+            k = std::min(lp, rp);
+        }
+
+        Offset pos = sa[mid];
+        while (k < m && pos + k < n && t[pos + k] == p[k]) ++k;
+
+        bool antes;
+        if (k == m) antes = superior;
+        else if (pos + k == n) antes = true;
+        else antes = (unsigned char)t[pos + k] < (unsigned char)p[k];
+
+        if (antes) { l = mid; lp = k; }
+        else { r = mid; rp = k; }
+    }
+    return r;
+}
+
+template <typename Offset>
+void intervaloSuffixArray(std::string_view texto,
+                          std::string_view patron,
+                          const Offset* sa,
+                          const Offset* lcpIzq,
+                          const Offset* lcpDer,
+                          Offset& desde,
+                          Offset& hasta) {
+    const char* t = texto.data();
+    const char* p = patron.data();
+    Offset n = texto.size(), m = patron.size();
+
+    desde = limiteRango(t, n, p, m, sa, lcpIzq, lcpDer, false);
+    hasta = limiteRango(t, n, p, m, sa, lcpIzq, lcpDer, true);
+}
+
+// Se hace búsqueda binaria del patrón en el texto usando el suffix array:
+// dos busquedas (limite inferior y superior) y el rango se copia de una vez
+template <typename Offset>
+std::vector<Offset> buscarConSuffixArray(std::string_view texto,
+                                         std::string_view patron,
+                                         const Offset* sa,
+                                         const Offset* lcpIzq,
+                                         const Offset* lcpDer) {
+    Offset desde, hasta;
+    intervaloSuffixArray(texto, patron, sa, lcpIzq, lcpDer, desde, hasta);
+    return std::vector<Offset>(sa + desde, sa + hasta);
+}
+
+template <typename Offset>
+void buscarConSuffixArray(std::string_view texto,
+                          std::string_view patron,
+                          const Offset* sa,
+                          const Offset* lcpIzq,
+                          const Offset* lcpDer,
+                          SumideroResultadosT<Offset>& sumidero) {
+    Offset desde, hasta;
+    intervaloSuffixArray(texto, patron, sa, lcpIzq, lcpDer, desde, hasta);
+    if (sumidero.modo == ModoResultado::Contar) {
+        sumidero.cuenta += hasta - desde;
+        return;
+    }
+    for (Offset i = desde; i < hasta; ++i) {
+        if (!sumidero.reportar(sa[i])) return;
+    }
+}
+
+template <typename Offset>
+std::vector<Offset> buscarConSuffixArray(std::string_view texto,
+                                         std::string_view patron,
+                                         const std::vector<Offset>& sa) {
+    return buscarConSuffixArray<Offset>(texto, patron, sa.data(), nullptr, nullptr);
+}
+
+template <typename Offset>
+std::vector<Offset> buscarConSuffixArray(std::string_view texto,
+                                         std::string_view patron,
+                                         const std::vector<Offset>& sa,
+                                         const LCPBusquedaT<Offset>& lcp) {
+    return buscarConSuffixArray(texto, patron, sa.data(), lcp.izq.data(), lcp.der.data());
+}
+
+template <typename Offset>
+void buscarConSuffixArray(std::string_view texto,
+                          std::string_view patron,
+                          const std::vector<Offset>& sa,
+                          const LCPBusquedaT<Offset>& lcp,
+                          SumideroResultadosT<Offset>& sumidero) {
+    buscarConSuffixArray(texto, patron, sa.data(), lcp.izq.data(), lcp.der.data(), sumidero);
+}
+
+// Instancias para offsets de 32 y 64 bits
+template std::vector<Offset32> construirSuffixArray<Offset32>(std::string_view, MetodoSA, int);
+template std::vector<Offset64> construirSuffixArray<Offset64>(std::string_view, MetodoSA, int);
+template std::vector<Offset32> construirLCP<Offset32>(std::string_view, const std::vector<Offset32>&);
+template std::vector<Offset64> construirLCP<Offset64>(std::string_view, const std::vector<Offset64>&);
+template LCPBusquedaT<Offset32> construirLCPBusqueda<Offset32>(const std::vector<Offset32>&);
+template LCPBusquedaT<Offset64> construirLCPBusqueda<Offset64>(const std::vector<Offset64>&);
+template std::vector<Offset32> buscarConSuffixArray<Offset32>(std::string_view, std::string_view, const Offset32*, const Offset32*, const Offset32*);
+template std::vector<Offset64> buscarConSuffixArray<Offset64>(std::string_view, std::string_view, const Offset64*, const Offset64*, const Offset64*);
+template void buscarConSuffixArray<Offset32>(std::string_view, std::string_view, const Offset32*, const Offset32*, const Offset32*, SumideroResultados&);
+template void buscarConSuffixArray<Offset64>(std::string_view, std::string_view, const Offset64*, const Offset64*, const Offset64*, SumideroResultados64&);
+template std::vector<Offset32> buscarConSuffixArray<Offset32>(std::string_view, std::string_view, const std::vector<Offset32>&);
+template std::vector<Offset64> buscarConSuffixArray<Offset64>(std::string_view, std::string_view, const std::vector<Offset64>&);
+template std::vector<Offset32> buscarConSuffixArray<Offset32>(std::string_view, std::string_view, const std::vector<Offset32>&, const LCPBusqueda&);
+template std::vector<Offset64> buscarConSuffixArray<Offset64>(std::string_view, std::string_view, const std::vector<Offset64>&, const LCPBusqueda64&);
+template void buscarConSuffixArray<Offset32>(std::string_view, std::string_view, const std::vector<Offset32>&, const LCPBusqueda&, SumideroResultados&);
+template void buscarConSuffixArray<Offset64>(std::string_view, std::string_view, const std::vector<Offset64>&, const LCPBusqueda64&, SumideroResultados64&);
+template void intervaloSuffixArray<Offset32>(std::string_view, std::string_view, const Offset32*, const Offset32*, const Offset32*, Offset32&, Offset32&);
+template void intervaloSuffixArray<Offset64>(std::string_view, std::string_view, const Offset64*, const Offset64*, const Offset64*, Offset64&, Offset64&);
@@ -3,10 +3,89 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include "resultados.h"
 
-std::vector<int> construirSuffixArray(const std::string& texto);
-std::vector<int> buscarConSuffixArray(const std::string& texto,
-                                      const std::string& patron,
-                                      const std::vector<int>& suffixArray);
+// Metodo de construccion del suffix array
+enum class MetodoSA {
+    SAIS,                // ordenamiento inducido, tiempo lineal (por defecto)
+    Duplicacion,         // duplicacion de prefijos con std::sort, O(n log^2 n)
+    DuplicacionParalela  // duplicacion por grupos (Larsson-Sadakane) en varios hilos
+};
+
+// Construye el suffix array. Offset32 por defecto (la mitad de memoria y mas
+// denso en cache); Offset64 para textos de mas de 2 GiB (ver necesitaOffset64).
+// 'hilos' solo se usa con DuplicacionParalela; el resultado es identico al de
+// SA-IS con cualquier cantidad de hilos.
+template <typename Offset = Offset32>
+std::vector<Offset> construirSuffixArray(std::string_view texto,
+                                         MetodoSA metodo = MetodoSA::SAIS,
+                                         int hilos = 1);
+
+// Arreglo LCP (Kasai): lcp[i] = prefijo comun entre los sufijos sa[i-1] y sa[i], lcp[0] = 0
+template <typename Offset>
+std::vector<Offset> construirLCP(std::string_view texto, const std::vector<Offset>& sa);
+
+// LCP de cada punto medio de la busqueda binaria con sus dos extremos
+// (Manber-Myers). Se indexa por el punto medio, que es unico en el arbol implicito.
+template <typename Offset>
+struct LCPBusquedaT {
+    std::vector<Offset> izq; // lcp(sa[l], sa[mid])
+    std::vector<Offset> der; // lcp(sa[mid], sa[r])
+};
+using LCPBusqueda = LCPBusquedaT<Offset32>;
+using LCPBusqueda64 = LCPBusquedaT<Offset64>;
+
+template <typename Offset>
+LCPBusquedaT<Offset> construirLCPBusqueda(const std::vector<Offset>& lcp);
+
+// Intervalo [desde, hasta) del suffix array con los sufijos que empiezan con
+// el patron (lcpIzq/lcpDer pueden ser nulos)
+template <typename Offset>
+void intervaloSuffixArray(std::string_view texto,
+                          std::string_view patron,
+                          const Offset* sa,
+                          const Offset* lcpIzq,
+                          const Offset* lcpDer,
+                          Offset& desde,
+                          Offset& hasta);
+
+// Devuelve las posiciones del patron (en orden del suffix array)
+template <typename Offset>
+std::vector<Offset> buscarConSuffixArray(std::string_view texto,
+                                         std::string_view patron,
+                                         const std::vector<Offset>& suffixArray);
+
+// Igual, pero usando la informacion LCP: O(m + log n) por consulta
+template <typename Offset>
+std::vector<Offset> buscarConSuffixArray(std::string_view texto,
+                                         std::string_view patron,
+                                         const std::vector<Offset>& suffixArray,
+                                         const LCPBusquedaT<Offset>& lcp);
+
+// Variante sobre arreglos externos (por ejemplo, un indice mapeado desde disco).
+// lcpIzq/lcpDer pueden ser nulos: entonces se busca sin la informacion LCP.
+template <typename Offset>
+std::vector<Offset> buscarConSuffixArray(std::string_view texto,
+                                         std::string_view patron,
+                                         const Offset* suffixArray,
+                                         const Offset* lcpIzq,
+                                         const Offset* lcpDer);
+
+// Entrega las posiciones al sumidero. Para solo contar no recorre el rango:
+// la cantidad es el tamaño del intervalo del suffix array.
+template <typename Offset>
+void buscarConSuffixArray(std::string_view texto,
+                          std::string_view patron,
+                          const Offset* suffixArray,
+                          const Offset* lcpIzq,
+                          const Offset* lcpDer,
+                          SumideroResultadosT<Offset>& sumidero);
+template <typename Offset>
+void buscarConSuffixArray(std::string_view texto,
+                          std::string_view patron,
+                          const std::vector<Offset>& suffixArray,
+                          const LCPBusquedaT<Offset>& lcp,
+                          SumideroResultadosT<Offset>& sumidero);
 
 #endif
@@ -1,81 +1,382 @@
 // Funciones comunes (lectura, timer, estadísticas)
 
 #include "io.h"
+#include "paralelo.h"
+#include "resultados.h"
+#include <cstring>
 #include <fstream>
 #include <string>
 #include <vector>
 #include <filesystem>
 #include <algorithm>
 
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace fs = std::filesystem;
 
-std::string leerDocumentosDesdeCarpeta(const std::string &carpeta, std::vector<std::string> &nombresDoc, std::vector<int> &cortes)
+// Documento a cargar: nombre, ruta y tamaño en disco
+struct ArchivoDoc
 {
-    std::vector<std::pair<std::string, std::string>> archivosContenido;
+    std::string nombre;
+    fs::path ruta;
+    size_t tam;
+};
 
+// Lista los .txt de la carpeta, ordenados por nombre
+static std::vector<ArchivoDoc> listarDocumentos(const std::string &carpeta)
+{
+    std::vector<ArchivoDoc> archivos;
     for (const auto &entry : fs::directory_iterator(carpeta))
     {
         if (entry.path().extension() == ".txt")
         {
-            std::ifstream file(entry.path());
-            if (!file.is_open())
-                continue;
+            std::error_code ec;
+            size_t tam = entry.file_size(ec);
+            archivos.push_back({entry.path().filename().string(), entry.path(), ec ? 0 : tam});
+        }
+    }
+    std::sort(archivos.begin(), archivos.end(),
+              [](const ArchivoDoc &a, const ArchivoDoc &b)
+              { return a.nombre < b.nombre; });
+    return archivos;
+}
 
-            std::string contenido((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-            std::string nombreArchivo = entry.path().filename().string();
+// Cota superior del texto concatenado: contenido mas un '$' por documento
+static size_t tamanoTotal(const std::vector<ArchivoDoc> &archivos)
+{
+    size_t total = 0;
+    for (const auto &a : archivos)
+    {
+        total += a.tam + 1;
+    }
+    return total;
+}
 
-            archivosContenido.push_back({nombreArchivo, contenido});
-        }
+// Lee hasta 'n' bytes del archivo directamente en 'destino' con lecturas grandes.
+// Devuelve false si no se pudo abrir; en 'leidos' queda lo que se leyo realmente.
+static bool leerArchivoEn(const fs::path &ruta, char *destino, size_t n, size_t &leidos)
+{
+    leidos = 0;
+#ifdef _WIN32
+    // Modo texto, igual que la lectura original con ifstream
+    std::ifstream file(ruta);
+    if (!file.is_open())
+        return false;
+    file.read(destino, n);
+    leidos = file.gcount();
+#else
+    int fd = open(ruta.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    while (leidos < n)
+    {
+        ssize_t r = read(fd, destino + leidos, n - leidos);
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r <= 0)
+            break;
+        leidos += r;
     }
+    close(fd);
+#endif
+    return true;
+}
 
-    std::sort(archivosContenido.begin(), archivosContenido.end());
+// Copia los documentos en 'buffer' (separados por '$') y llena 'cortes' (y
+// 'nombresDoc' si no es nulo). Cada documento tiene reservado su lugar segun su
+// tamaño en disco, asi varios hilos pueden leer a la vez sin coordinarse; al
+// final se compacta en orden (solo mueve datos si algun archivo no se pudo
+// abrir o resulto mas corto), por lo que el resultado es identico al de una
+// lectura secuencial. Devuelve la cantidad de bytes usados del buffer.
+template <typename Offset>
+static size_t llenarBuffer(const std::vector<ArchivoDoc> &archivos, char *buffer,
+                           std::vector<std::string> *nombresDoc, std::vector<Offset> &cortes,
+                           int hilos)
+{
+    size_t numDocs = archivos.size();
+    std::vector<size_t> inicio(numDocs), leidos(numDocs, 0);
+    std::vector<char> abierto(numDocs, 0);
+    size_t total = 0;
+    for (size_t i = 0; i < numDocs; ++i)
+    {
+        inicio[i] = total;
+        total += archivos[i].tam + 1;
+    }
+    verificarTamTexto<Offset>(total); // los cortes son de tipo Offset
 
-    std::string textoTotal;
-    int acumulado = 0;
-    nombresDoc.clear();
+    paraleloPara(numDocs, hilos, [&](size_t i)
+                 { abierto[i] = leerArchivoEn(archivos[i].ruta, buffer + inicio[i], archivos[i].tam, leidos[i]); });
+
+    size_t acumulado = 0;
     cortes.clear();
+    if (nombresDoc)
+        nombresDoc->clear();
 
-    for (const auto &[nombre, contenido] : archivosContenido)
+    for (size_t i = 0; i < numDocs; ++i)
     {
-        textoTotal += contenido + '$';
-        acumulado = textoTotal.size();
+        if (!abierto[i])
+            continue;
+
+        if (inicio[i] != acumulado)
+            std::memmove(buffer + acumulado, buffer + inicio[i], leidos[i]);
+        acumulado += leidos[i];
+        buffer[acumulado++] = '$';
         cortes.push_back(acumulado);
-        nombresDoc.push_back(nombre);
+        if (nombresDoc)
+            nombresDoc->push_back(archivos[i].nombre);
     }
+    return acumulado;
+}
 
+bool cargarCorpus(const std::string &carpeta, Corpus &corpus, int hilos)
+{
+    auto archivos = listarDocumentos(carpeta);
+
+    // Un solo buffer del tamaño final, sin inicializar
+    corpus.buffer.reset(new char[tamanoTotal(archivos)]);
+    corpus.tam = llenarBuffer(archivos, corpus.buffer.get(), &corpus.nombres, corpus.cortes, hilos);
+    return !corpus.cortes.empty();
+}
+
+std::string_view Corpus::texto() const
+{
+    return std::string_view(buffer.get(), tam);
+}
+
+template <typename Offset>
+std::string leerDocumentosDesdeCarpeta(const std::string &carpeta, std::vector<std::string> &nombresDoc, std::vector<Offset> &cortes, int hilos)
+{
+    auto archivos = listarDocumentos(carpeta);
+
+    std::string textoTotal;
+    textoTotal.resize(tamanoTotal(archivos));
+    textoTotal.resize(llenarBuffer(archivos, textoTotal.data(), &nombresDoc, cortes, hilos));
     return textoTotal;
 }
 
+template <typename Offset>
 std::string concatenarDocumentosSeleccionados(const std::string &carpeta,
                                               const std::vector<std::string> &docsSeleccionados,
-                                              std::vector<int> &cortes)
+                                              std::vector<Offset> &cortes,
+                                              int hilos)
 {
+    std::vector<ArchivoDoc> archivos;
+    for (const auto &nombreArchivo : docsSeleccionados)
+    {
+        fs::path ruta = fs::path(carpeta) / nombreArchivo;
+        std::error_code ec;
+        size_t tam = fs::file_size(ruta, ec);
+        if (ec)
+            continue;
+        archivos.push_back({nombreArchivo, ruta, tam});
+    }
+
     std::string textoTotal;
-    int acumulado = 0;
-    cortes.clear();
+    textoTotal.resize(tamanoTotal(archivos));
+    textoTotal.resize(llenarBuffer(archivos, textoTotal.data(), nullptr, cortes, hilos));
+    return textoTotal;
+}
 
-    for (const auto &nombreArchivo : docsSeleccionados)
+uint64_t recorrerCarpetaPorBloques(const std::string &carpeta, size_t tamBloque,
+                                   const std::function<bool(std::string_view)> &procesarBloque,
+                                   const std::function<void(const std::string &, uint64_t)> &finDocumento)
+{
+    if (tamBloque == 0)
+        tamBloque = 1;
+    std::unique_ptr<char[]> bloque(new char[tamBloque]);
+    size_t usados = 0;   // bytes pendientes en el bloque
+    uint64_t total = 0;  // bytes agregados al bloque desde el inicio
+    uint64_t entregados = 0;
+    bool seguir = true;
+
+    // Entrega el bloque si esta lleno (o si 'forzar' y queda algo pendiente)
+    auto vaciar = [&](bool forzar)
+    {
+        if (usados == tamBloque || (forzar && usados > 0))
+        {
+            seguir = procesarBloque(std::string_view(bloque.get(), usados));
+            entregados += usados;
+            usados = 0;
+        }
+    };
+
+    for (const auto &archivo : listarDocumentos(carpeta))
     {
-        std::ifstream file(carpeta + "/" + nombreArchivo);
+        if (!seguir)
+            break;
+#ifdef _WIN32
+        // Modo texto, igual que leerArchivoEn
+        std::ifstream file(archivo.ruta);
         if (!file.is_open())
             continue;
-
-        std::string contenido((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-        textoTotal += contenido + '$';
-        acumulado = textoTotal.size();
-        cortes.push_back(acumulado);
+        while (file && seguir)
+        {
+            file.read(bloque.get() + usados, tamBloque - usados);
+            size_t r = file.gcount();
+            usados += r;
+            total += r;
+            vaciar(false);
+        }
+#else
+        int fd = open(archivo.ruta.c_str(), O_RDONLY);
+        if (fd < 0)
+            continue;
+        while (seguir)
+        {
+            ssize_t r = read(fd, bloque.get() + usados, tamBloque - usados);
+            if (r < 0 && errno == EINTR)
+                continue;
+            if (r <= 0)
+                break;
+            usados += r;
+            total += r;
+            vaciar(false);
+        }
+        close(fd);
+#endif
+        if (!seguir)
+            break;
+        bloque[usados++] = '$';
+        total++;
+        vaciar(false);
+        if (finDocumento)
+            finDocumento(archivo.nombre, total);
     }
-    return textoTotal;
+    if (seguir)
+        vaciar(true);
+    return entregados;
 }
 
-int obtenerDocumento(int pos, const std::vector<int> &cortes)
+template <typename Offset>
+int obtenerDocumento(int64_t pos, const std::vector<Offset> &cortes)
 {
-    for (size_t i = 0; i < cortes.size(); ++i)
+    return obtenerDocumento(pos, cortes.data(), cortes.size());
+}
+
+template <typename Offset>
+int obtenerDocumento(int64_t pos, const Offset *cortes, size_t numDocs)
+{
+    // Primer corte mayor que pos: ese documento contiene la posicion
+    const Offset *c = std::upper_bound(cortes, cortes + numDocs, pos,
+                                       [](int64_t p, Offset corte)
+                                       { return p < (int64_t)corte; });
+    if (c == cortes + numDocs)
+        return -1;
+    return (int)(c - cortes) + 1;
+}
+
+// Recorre las posiciones avanzando el documento actual; llama a 'visitar'
+// con el indice (base 0, numDocs si queda fuera) y el inicio del documento
+template <typename Offset, typename Visitar>
+static void recorrerPorDocumento(const std::vector<Offset> &posiciones, const Offset *cortes, size_t numDocs,
+                                 Visitar visitar)
+{
+    size_t d = 0;
+    for (Offset pos : posiciones)
     {
-        if (pos < cortes[i])
+        int64_t inicio = d == 0 ? 0 : (int64_t)cortes[d - 1];
+        if (pos < inicio)
         {
-            return i + 1;
+            // Posicion fuera de orden: reubicar con busqueda binaria
+            int doc = obtenerDocumento(pos, cortes, numDocs);
+            d = doc < 0 ? numDocs : doc - 1;
         }
+        while (d < numDocs && pos >= cortes[d])
+            ++d;
+        visitar(d, pos, d == 0 ? 0 : (int64_t)cortes[d - 1]);
+    }
+}
+
+template <typename Offset>
+std::vector<UbicacionDoc> ubicarEnDocumentos(const std::vector<Offset> &posiciones, const Offset *cortes, size_t numDocs)
+{
+    std::vector<UbicacionDoc> ubicaciones;
+    ubicaciones.reserve(posiciones.size());
+    recorrerPorDocumento(posiciones, cortes, numDocs, [&](size_t d, int64_t pos, int64_t inicio)
+                         {
+                             if (d == numDocs)
+                                 ubicaciones.push_back({-1, pos});
+                             else
+                                 ubicaciones.push_back({(int)d + 1, pos - inicio}); });
+    return ubicaciones;
+}
+
+template <typename Offset>
+std::vector<int> histogramaDocumentos(const std::vector<Offset> &posiciones, const Offset *cortes, size_t numDocs)
+{
+    std::vector<int> cuenta(numDocs, 0);
+    recorrerPorDocumento(posiciones, cortes, numDocs, [&](size_t d, int64_t, int64_t)
+                         {
+                             if (d < numDocs)
+                                 cuenta[d]++; });
+    return cuenta;
+}
+
+template std::string leerDocumentosDesdeCarpeta<int>(const std::string &, std::vector<std::string> &, std::vector<int> &, int);
+template std::string leerDocumentosDesdeCarpeta<int64_t>(const std::string &, std::vector<std::string> &, std::vector<int64_t> &, int);
+template std::string concatenarDocumentosSeleccionados<int>(const std::string &, const std::vector<std::string> &, std::vector<int> &, int);
+template std::string concatenarDocumentosSeleccionados<int64_t>(const std::string &, const std::vector<std::string> &, std::vector<int64_t> &, int);
+template int obtenerDocumento<int>(int64_t, const std::vector<int> &);
+template int obtenerDocumento<int64_t>(int64_t, const std::vector<int64_t> &);
+template int obtenerDocumento<int>(int64_t, const int *, size_t);
+template int obtenerDocumento<int64_t>(int64_t, const int64_t *, size_t);
+template std::vector<UbicacionDoc> ubicarEnDocumentos<int>(const std::vector<int> &, const int *, size_t);
+template std::vector<UbicacionDoc> ubicarEnDocumentos<int64_t>(const std::vector<int64_t> &, const int64_t *, size_t);
+template std::vector<int> histogramaDocumentos<int>(const std::vector<int> &, const int *, size_t);
+template std::vector<int> histogramaDocumentos<int64_t>(const std::vector<int64_t> &, const int64_t *, size_t);
+
+static void fnv1a(uint64_t &h, const void *datos, size_t n)
+{
+    const unsigned char *p = static_cast<const unsigned char *>(datos);
+    for (size_t i = 0; i < n; ++i)
+    {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+}
+
+uint64_t checksumCorpus(const std::string &carpeta)
+{
+    std::vector<std::pair<std::string, fs::path>> archivos;
+    std::error_code ec;
+    for (const auto &entry : fs::directory_iterator(carpeta, ec))
+    {
+        if (entry.path().extension() == ".txt")
+            archivos.push_back({entry.path().filename().string(), entry.path()});
+    }
+    std::sort(archivos.begin(), archivos.end());
+
+    uint64_t h = 1469598103934665603ULL;
+    for (const auto &[nombre, ruta] : archivos)
+    {
+        uint64_t tam = fs::file_size(ruta, ec);
+        int64_t fecha = fs::last_write_time(ruta, ec).time_since_epoch().count();
+        fnv1a(h, nombre.data(), nombre.size() + 1);
+        fnv1a(h, &tam, sizeof(tam));
+        fnv1a(h, &fecha, sizeof(fecha));
+    }
+    return h;
+}
+
+std::vector<std::pair<std::string, uint64_t>> huellasDocumentos(const std::string &carpeta)
+{
+    std::vector<std::pair<std::string, uint64_t>> huellas;
+    std::error_code ec;
+    for (const auto &entry : fs::directory_iterator(carpeta, ec))
+    {
+        if (entry.path().extension() != ".txt")
+            continue;
+        uint64_t tam = fs::file_size(entry.path(), ec);
+        int64_t fecha = fs::last_write_time(entry.path(), ec).time_since_epoch().count();
+        uint64_t h = 1469598103934665603ULL;
+        fnv1a(h, &tam, sizeof(tam));
+        fnv1a(h, &fecha, sizeof(fecha));
+        huellas.push_back({entry.path().filename().string(), h});
     }
-    return -1;
+    std::sort(huellas.begin(), huellas.end());
+    return huellas;
 }
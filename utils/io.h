@@ -2,21 +2,95 @@
 #define IO_H
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+// Corpus concatenado en un unico buffer (documentos separados por '$')
+struct Corpus
+{
+    std::unique_ptr<char[]> buffer;
+    size_t tam = 0;
+    std::vector<std::string> nombres; // nombres de los documentos, en orden
+    std::vector<int64_t> cortes;      // posicion donde termina cada documento (64 bits, sin limite de tamaño)
+
+    // Vista de solo lectura sobre el texto concatenado
+    std::string_view texto() const;
+};
+
+// Carga los .txt de la carpeta (ordenados por nombre) en un buffer que se reserva
+// una sola vez a partir de los tamaños de archivo y se llena con lecturas grandes
+// directas. El pico de memoria es ~1x el corpus. Con hilos > 1 los archivos se
+// leen en paralelo; el orden y los cortes son los mismos que con un solo hilo.
+// Devuelve false si no hay documentos.
+bool cargarCorpus(const std::string &carpeta, Corpus &corpus, int hilos = 1);
 
 // Lee todos los archivos .txt desde una carpeta, los concatena con '$'
 // Guarda en 'nombresDoc' los nombres de los archivos (documentos)
 // Guarda en 'cortes' las posiciones donde termina cada documento en el texto concatenado
+// (int o int64_t; con int el texto debe caber en 2 GiB)
+template <typename Offset>
 std::string leerDocumentosDesdeCarpeta(
     const std::string &carpeta,
     std::vector<std::string> &nombresDoc,
-    std::vector<int> &cortes);
+    std::vector<Offset> &cortes,
+    int hilos = 1);
 
 // Lee y concatena sólo los documentos seleccionados (por nombre) en 'docsSeleccionados'
 // Igual guarda en 'cortes' las posiciones de corte
-std::string concatenarDocumentosSeleccionados(const std::string &carpeta, const std::vector<std::string> &docsSeleccionados, std::vector<int> &cortes);
+template <typename Offset>
+std::string concatenarDocumentosSeleccionados(const std::string &carpeta, const std::vector<std::string> &docsSeleccionados, std::vector<Offset> &cortes, int hilos = 1);
+
+// Recorre los .txt de la carpeta (ordenados por nombre) de a un archivo,
+// entregando a 'procesarBloque' bloques de a lo sumo 'tamBloque' bytes: la misma
+// secuencia que cargarCorpus (cada documento seguido de '$') pero sin armar la
+// concatenacion, asi la memoria es un solo bloque sin importar el tamaño de la
+// carpeta. Tras el '$' de cada documento se llama a 'finDocumento' (si no es
+// nulo) con su nombre y su corte global en 64 bits (ese '$' puede estar aun en
+// el bloque pendiente). Si 'procesarBloque' devuelve false se deja de leer.
+// Devuelve el total de bytes entregados.
+uint64_t recorrerCarpetaPorBloques(const std::string &carpeta, size_t tamBloque,
+                                   const std::function<bool(std::string_view bloque)> &procesarBloque,
+                                   const std::function<void(const std::string &nombre, uint64_t corte)> &finDocumento = nullptr);
 
 // Dado una posición en el texto concatenado, indica a qué documento pertenece
-int obtenerDocumento(int pos, const std::vector<int> &cortes);
+// (base 1, -1 si esta despues del ultimo corte). Busqueda binaria sobre los
+// cortes de int o int64_t: O(log D).
+template <typename Offset>
+int obtenerDocumento(int64_t pos, const std::vector<Offset> &cortes);
+template <typename Offset>
+int obtenerDocumento(int64_t pos, const Offset *cortes, size_t numDocs);
+
+// Posicion de una coincidencia dentro de su documento
+struct UbicacionDoc
+{
+    int doc;        // documento (base 1, como obtenerDocumento; -1 si no hay)
+    int64_t offset; // posicion desde el inicio del documento
+};
+
+// Ubica todas las posiciones de una vez. Si vienen ordenadas es una sola
+// pasada de mezcla con los cortes, O(hits + D); si alguna retrocede se vuelve
+// a ubicar con busqueda binaria, asi el resultado es correcto en cualquier orden.
+template <typename Offset>
+std::vector<UbicacionDoc> ubicarEnDocumentos(const std::vector<Offset> &posiciones, const Offset *cortes, size_t numDocs);
+
+// Cantidad de coincidencias por documento (indice base 0, tamaño numDocs),
+// con la misma pasada de mezcla. Los documentos que contienen el patron son
+// los de cuenta > 0.
+template <typename Offset>
+std::vector<int> histogramaDocumentos(const std::vector<Offset> &posiciones, const Offset *cortes, size_t numDocs);
+
+// Huella rapida del corpus (FNV-1a de nombre, tamaño y fecha de modificacion de
+// cada .txt). No lee el contenido; sirve para saber si un indice sigue vigente.
+uint64_t checksumCorpus(const std::string &carpeta);
+
+// Huella de cada .txt de la carpeta (FNV-1a de tamaño y fecha de modificacion),
+// ordenados por nombre. Sirve para detectar documentos nuevos, borrados o
+// modificados sin leer su contenido.
+std::vector<std::pair<std::string, uint64_t>> huellasDocumentos(const std::string &carpeta);
 
 #endif
@@ -0,0 +1,126 @@
+#include "paralelo.h"
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+
+int hilosDisponibles()
+{
+    unsigned int n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : (int)n;
+}
+
+void paraleloPara(size_t numTareas, int hilos, const std::function<void(size_t)> &tarea)
+{
+    if (hilos > (int)numTareas)
+        hilos = numTareas;
+    if (hilos <= 1)
+    {
+        for (size_t i = 0; i < numTareas; ++i)
+            tarea(i);
+        return;
+    }
+
+    std::atomic<size_t> siguiente{0};
+    auto trabajador = [&]()
+    {
+        for (size_t i = siguiente++; i < numTareas; i = siguiente++)
+            tarea(i);
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(hilos - 1);
+    for (int h = 1; h < hilos; ++h)
+        pool.emplace_back(trabajador);
+    trabajador();
+    for (auto &t : pool)
+        t.join();
+}
+
+// Rango de tareas pendientes de un hilo: [inicio, fin)
+struct ColaRobo
+{
+    std::mutex mtx;
+    size_t inicio = 0;
+    size_t fin = 0;
+};
+
+void paraleloRobo(size_t numTareas, int hilos, const std::function<void(size_t)> &tarea)
+{
+    if (hilos > (int)numTareas)
+        hilos = numTareas;
+    if (hilos <= 1)
+    {
+        for (size_t i = 0; i < numTareas; ++i)
+            tarea(i);
+        return;
+    }
+
+    // Reparto inicial en bloques contiguos del mismo tamaño
+    std::unique_ptr<ColaRobo[]> colas(new ColaRobo[hilos]);
+    for (int h = 0; h < hilos; ++h)
+    {
+        colas[h].inicio = numTareas * h / hilos;
+        colas[h].fin = numTareas * (h + 1) / hilos;
+    }
+
+    auto trabajador = [&](int yo)
+    {
+        ColaRobo &propia = colas[yo];
+        while (true)
+        {
+            // Tomar la siguiente tarea propia
+            size_t i;
+            {
+                std::lock_guard<std::mutex> lock(propia.mtx);
+                i = propia.inicio < propia.fin ? propia.inicio++ : numTareas;
+            }
+            if (i < numTareas)
+            {
+                tarea(i);
+                continue;
+            }
+
+            // Sin trabajo propio: robar la mitad final al hilo mas cargado
+            int victima = -1;
+            size_t maxPendientes = 0;
+            for (int h = 0; h < hilos; ++h)
+            {
+                if (h == yo)
+                    continue;
+                std::lock_guard<std::mutex> lock(colas[h].mtx);
+                size_t pendientes = colas[h].fin - colas[h].inicio;
+                if (pendientes > maxPendientes)
+                {
+                    maxPendientes = pendientes;
+                    victima = h;
+                }
+            }
+            if (victima < 0)
+                return;
+
+            size_t desde, hasta;
+            {
+                std::lock_guard<std::mutex> lock(colas[victima].mtx);
+                size_t pendientes = colas[victima].fin - colas[victima].inicio;
+                if (pendientes == 0)
+                    continue;
+                hasta = colas[victima].fin;
+                desde = hasta - (pendientes + 1) / 2;
+                colas[victima].fin = desde;
+            }
+            std::lock_guard<std::mutex> lock(propia.mtx);
+            propia.inicio = desde;
+            propia.fin = hasta;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(hilos - 1);
+    for (int h = 1; h < hilos; ++h)
+        pool.emplace_back(trabajador, h);
+    trabajador(0);
+    for (auto &t : pool)
+        t.join();
+}
@@ -0,0 +1,21 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <cstddef>
+#include <functional>
+
+// Cantidad de hilos del equipo (minimo 1)
+int hilosDisponibles();
+
+// Ejecuta tarea(i) para cada i en [0, numTareas) usando a lo sumo 'hilos' hilos.
+// Las tareas se reparten dinamicamente con un contador atomico; con hilos <= 1
+// (o una sola tarea) todo se ejecuta en el hilo que llama.
+void paraleloPara(size_t numTareas, int hilos, const std::function<void(size_t)> &tarea);
+
+// Igual que paraleloPara, pero con robo de trabajo: cada hilo parte con un bloque
+// contiguo de tareas y las consume desde el inicio; cuando se queda sin trabajo
+// le roba la mitad final de lo pendiente al hilo con mas tareas restantes.
+// Conviene cuando el costo de las tareas es muy desigual.
+void paraleloRobo(size_t numTareas, int hilos, const std::function<void(size_t)> &tarea);
+
+#endif